@@ -7,15 +7,18 @@
 ******************************************************************************/
 
 #include "FlexSplinePrivatePCH.h"
+#include "FlexSplineConstructionManager.h"
 
 #define LOCTEXT_NAMESPACE "FFlexSplineModule"
 
 void FFlexSplineModule::StartupModule()
 {
+    FFlexSplineConstructionManager::Startup();
 }
 
 void FFlexSplineModule::ShutdownModule()
 {
+    FFlexSplineConstructionManager::Shutdown();
 }
 
 #undef LOCTEXT_NAMESPACE
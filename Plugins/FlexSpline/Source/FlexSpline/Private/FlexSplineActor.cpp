@@ -8,12 +8,19 @@
 
 #include "FlexSplinePrivatePCH.h"
 #include "FlexSplineActor.h"
-#include "Algo/Reverse.h"
+#include "FlexSplineBatchKernels.h"
 #include "Components/SplineComponent.h"
 #include "Components/SplineMeshComponent.h"
-#include "Components/ArrowComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
 #include "Components/TextRenderComponent.h"
-#include "Kismet/KismetMathLibrary.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+#include "FlexSplineDebugComponent.h"
+#include "FlexSplineLayerPreset.h"
+#include "FlexSplineConstructionManager.h"
+#include "HAL/IConsoleManager.h"
+#include "Async/ParallelFor.h"
+#include "EngineUtils.h"
 
 // Helper aliases, for terser code
 static const auto StaticMeshClass = UStaticMeshComponent::StaticClass();
@@ -21,77 +28,326 @@ static const auto SplineMeshClass = USplineMeshComponent::StaticClass();
 static const auto LocalSpace      = ESplineCoordinateSpace::Local;
 static const auto WorldSpace      = ESplineCoordinateSpace::World;
 
+static TAutoConsoleVariable<int32> CVarMaxPooledComponents(
+    TEXT("flexspline.MaxPooledComponents"),
+    4096,
+    TEXT("Maximum number of unregistered components per class each Flex Spline keeps for reuse."),
+    ECVF_Default);
+
+static TAutoConsoleVariable<int32> CVarParallelConstruction(
+    TEXT("flexspline.ParallelConstruction"),
+    1,
+    TEXT("Resolve Flex Spline segments on worker threads. 0: Game thread only, 1: Parallel"),
+    ECVF_Default);
+
+/** Number of consecutive spline points whose random values are generated together */
+static const int32 RandomBatchSize = 256;
+
+/** Number of visible static meshes of a layer whose transforms are composed together */
+static const int32 StaticMeshBatchSize = 256;
+
+/** Arc length samples between two spline points, for layers placed by distance */
+static const int32 ArcLengthSamplesPerSegment = 16;
+
+DECLARE_DWORD_COUNTER_STAT(TEXT("Segments Updated"), STAT_FlexSplineSegmentsUpdated, STATGROUP_FlexSpline);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Components Created"), STAT_FlexSplineComponentsCreated, STATGROUP_FlexSpline);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Components Reused"), STAT_FlexSplineComponentsReused, STATGROUP_FlexSpline);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Components Pooled"), STAT_FlexSplineComponentsPooled, STATGROUP_FlexSpline);
+DECLARE_DWORD_COUNTER_STAT(TEXT("Components Destroyed"), STAT_FlexSplineComponentsDestroyed, STATGROUP_FlexSpline);
+DECLARE_MEMORY_STAT(TEXT("Point Data"), STAT_FlexSplinePointDataMemory, STATGROUP_FlexSpline);
+DECLARE_MEMORY_STAT(TEXT("Layer Data"), STAT_FlexSplineLayerDataMemory, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Construct Spline Mesh"), STAT_FlexSplineConstructSplineMesh, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Apply Baked Layout"), STAT_FlexSplineApplyBakedLayout, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Queue Pending Segments"), STAT_FlexSplineQueuePendingSegments, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Process Pending Segments"), STAT_FlexSplineProcessPendingSegments, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Initialize New Mesh Data"), STAT_FlexSplineInitializeNewMeshData, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Gather Layers"), STAT_FlexSplineGatherLayers, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Spline Frames"), STAT_FlexSplineUpdateSplineFrames, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Arc Length Table"), STAT_FlexSplineUpdateArcLengthTable, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Diff Spline Points"), STAT_FlexSplineDiffSplinePoints, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Apply Point Diff"), STAT_FlexSplineApplyPointDiff, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Point Data"), STAT_FlexSplineUpdatePointData, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Gather Dirty Segments"), STAT_FlexSplineGatherDirtySegments, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Prepare Mesh Components"), STAT_FlexSplinePrepareMeshComponents, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Resolve Segments"), STAT_FlexSplineResolveSegments, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Resolve Adaptive Segments"), STAT_FlexSplineResolveAdaptiveSegments, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Resolve Distributed Segments"), STAT_FlexSplineResolveDistributedSegments, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Sample Curves"), STAT_FlexSplineSampleCurves, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Mesh Components"), STAT_FlexSplineUpdateMeshComponents, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Spline Mesh"), STAT_FlexSplineUpdateSplineMesh, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Static Mesh"), STAT_FlexSplineUpdateStaticMesh, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Instanced Mesh"), STAT_FlexSplineUpdateInstancedMesh, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Adaptive Meshes"), STAT_FlexSplineUpdateAdaptiveMeshes, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Distributed Meshes"), STAT_FlexSplineUpdateDistributedMeshes, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Update Merged Meshes"), STAT_FlexSplineUpdateMergedMeshes, STATGROUP_FlexSpline);
+
 //////////////////////////////////////////////////////////////////////////
 // STATIC HELPERS
-static FColor GetColorForArrow(int32 MeshIndex)
+/** Random channels, keys and placement math are shared with the engine-independent core */
+namespace EFlexRandomChannel = FlexSplineMath::ERandomChannel;
+using FlexSplineMath::MixRandomBits;
+using FlexSplineMath::CombineRandomKey;
+using FlexSplineMath::RandomUnit;
+using FlexSplineMath::RandomSigned;
+using FlexSplineMath::CanRenderFromAccumulatedSpawnChance;
+
+/** Adds the wall time of its scope to a phase of FFlexConstructionTimings */
+struct FFlexScopedPhaseTimer
+{
+    double& PhaseTime;
+    const double StartTime;
+
+    explicit FFlexScopedPhaseTimer(double& InPhaseTime)
+        : PhaseTime(InPhaseTime)
+        , StartTime(FPlatformTime::Seconds())
+    {
+    }
+
+    ~FFlexScopedPhaseTimer()
+    {
+        PhaseTime += FPlatformTime::Seconds() - StartTime;
+    }
+};
+
+static_assert(sizeof(FFlexRenderRange) == sizeof(FlexSplineMath::FFlexMathRenderRange), "FFlexMathRenderRange must match the layout of FFlexRenderRange");
+
+/** Placement settings of a layer, as consumed by the math core */
+static FlexSplineMath::FFlexMathPlacement MakePlacement(const FSplineMeshInitData& MeshInitData)
 {
-    static const TArray<FColor> colors = {
-          FColor::Orange
-        , FColor::Green
-        , FColor::Blue
-        , FColor::Red
-        , FColor::Emerald
-        , FColor::Magenta
-        , FColor::Cyan
-        , FColor::Yellow
-        , FColor::Purple
-        , FColor::Turquoise
-        , FColor::Silver
-    };
+    FlexSplineMath::FFlexMathPlacement placement;
+    placement.bLocationLocalToPoint    = MeshInitData.LocationInfo.CoordinateSystem == EFlexCoordinateSystem::SplinePoint;
+    placement.bRotationLocalToPoint    = MeshInitData.RotationInfo.CoordinateSystem == EFlexCoordinateSystem::SplinePoint;
+    placement.bUpDirectionLocalToPoint = MeshInitData.UpVectorInfo.CoordinateSystem == EFlexCoordinateSystem::SplinePoint;
+    placement.Location                 = ToMath(MeshInitData.LocationInfo.Location);
+    placement.Rotation                 = ToMath(MeshInitData.RotationInfo.Rotation);
+    placement.Scale                    = ToMath(MeshInitData.ScaleInfo.bUseUniformScale
+                                                ? FVector(MeshInitData.ScaleInfo.UniformScale)
+                                                : MeshInitData.ScaleInfo.Scale);
+    placement.UpDirection              = ToMath(MeshInitData.UpVectorInfo.CustomMeshUpDirection);
+    return placement;
+}
 
-    MeshIndex = FMath::Clamp(MeshIndex, 0, colors.Num()-1);
-    return colors[MeshIndex];
+/** Hash plain old data, e.g. floats, vectors and rotators */
+template <typename T>
+static uint32 HashValue(const T& Value, uint32 Crc)
+{
+    return FCrc::MemCrc32(&Value, sizeof(T), Crc);
 }
 
-static float RandomizeFloat(float InFloat, int32 Index, FName Layername)
+static uint32 GenerateSplineFrameHash(const FFlexSplineFrame& Frame)
 {
-    const int32 seed  = GetTypeHash(InFloat) / 2
-                      + GetTypeHash(Layername) / 2
-                      + static_cast<int32>(InFloat)
-                      - Index;
-    return ( InFloat * UKismetMathLibrary::RandomFloatInRangeFromStream(-1.f, 1.f, FRandomStream(seed)) );
+    uint32 result = 0;
+    result = HashValue(Frame.Location, result);
+    result = HashValue(Frame.Tangent, result);
+    result = HashValue(Frame.Rotation, result);
+    result = HashValue(Frame.Scale, result);
+    return result;
 }
 
-static FVector RandomizeVector(const FVector& InVec, int32 Index, FName Layername)
+static uint32 GeneratePointDataHash(const FFlexPointDataChannels& PointData, int32 Index, uint32 Crc)
 {
-    float randX = 0.f;
-    float randY = 0.f;
-    float randZ = 0.f;
+    Crc = HashValue(PointData.GetStartRoll(Index), Crc);
+    Crc = HashValue(PointData.GetEndRoll(Index), Crc);
+    Crc = HashValue(PointData.GetStartScale(Index), Crc);
+    Crc = HashValue(PointData.GetEndScale(Index), Crc);
+    Crc = HashValue(PointData.GetStartOffset(Index), Crc);
+    Crc = HashValue(PointData.GetEndOffset(Index), Crc);
+    Crc = HashValue(PointData.GetUpDirection(Index), Crc);
+    Crc = HashValue(PointData.Flags[Index], Crc);
+    Crc = HashValue(PointData.GetSMLocationOffset(Index), Crc);
+    Crc = HashValue(PointData.GetSMScale(Index), Crc);
+    Crc = HashValue(PointData.GetSMRotation(Index), Crc);
+    Crc = HashValue(PointData.PointIDs[Index], Crc); // Random values are keyed on the identifier
+    return Crc;
+}
 
-    if (InVec.X != 0)
-        randX = RandomizeFloat(InVec.X, Index, Layername);
-    if (InVec.Y != 0)
-        randY = RandomizeFloat(InVec.Y, Index, Layername);
-    if (InVec.Z != 0)
-        randZ = RandomizeFloat(InVec.Z, Index, Layername);
+/** Hash the keys of @param Curve, so edits of a curve asset dirty everything sampling it */
+static uint32 HashRichCurve(const FRichCurve& Curve, uint32 Crc)
+{
+    Crc = HashValue(Curve.PreInfinityExtrap, Crc);
+    Crc = HashValue(Curve.PostInfinityExtrap, Crc);
+    Crc = HashValue(Curve.DefaultValue, Crc);
+    for (const FRichCurveKey& key : Curve.Keys)
+    {
+        Crc = HashValue(key.InterpMode, Crc);
+        Crc = HashValue(key.Time, Crc);
+        Crc = HashValue(key.Value, Crc);
+        Crc = HashValue(key.ArriveTangent, Crc);
+        Crc = HashValue(key.LeaveTangent, Crc);
+    }
+    return Crc;
+}
 
-    return FVector(randX, randY, randZ);
+/** Hash the domain, assets and keys of all curves of @param CurveInfo */
+static uint32 HashCurveInfo(const FFlexCurveInfo& CurveInfo, uint32 Crc)
+{
+    Crc = HashValue(CurveInfo.Domain, Crc);
+    Crc = HashValue(CurveInfo.Roll, Crc);
+    if (CurveInfo.Roll)
+    {
+        Crc = HashRichCurve(CurveInfo.Roll->FloatCurve, Crc);
+    }
+    for (const UCurveVector* curve : { CurveInfo.Scale, CurveInfo.Offset, CurveInfo.UpDirection, CurveInfo.SMLocationOffset, CurveInfo.SMScale, CurveInfo.SMRotation })
+    {
+        Crc = HashValue(curve, Crc);
+        if (curve)
+        {
+            for (const FRichCurve& floatCurve : curve->FloatCurves)
+            {
+                Crc = HashRichCurve(floatCurve, Crc);
+            }
+        }
+    }
+    return Crc;
 }
 
-static FRotator RandomizeRotator(const FRotator& InRot, int32 Index, FName Layername)
+/** Hash all layer settings that affect its meshes. Debug-only settings are excluded */
+static uint32 GenerateLayerSettingsHash(const FSplineMeshInitData& MeshInitData)
 {
-    // Maps rotator values onto a vector, randomizes, then reverses back to rotator
-    FVector vecFromRot = FVector(InRot.Pitch, InRot.Yaw, InRot.Roll);
-    vecFromRot = RandomizeVector(vecFromRot, Index, Layername);
+    uint32 crc = MeshInitData.LayerSeed; // Covers the actor seed and the layer identifier
+    crc = HashValue(MeshInitData.GeneralInfo, crc);
+
+    crc = HashValue(MeshInitData.MeshInfo.MeshType, crc);
+    crc = HashValue(MeshInitData.MeshInfo.MeshForwardAxis, crc);
+    crc = HashValue(MeshInitData.MeshInfo.Mesh, crc);
+    crc = HashValue(MeshInitData.MeshInfo.MeshMaterial, crc);
+    const bool bUseInstancing = MeshInitData.MeshInfo.bUseInstancing;
+    crc = HashValue(bUseInstancing, crc);
+
+    const bool bRandomizeSpawnChance = MeshInitData.RenderInfo.bRandomizeSpawnChance;
+    crc = HashValue(bRandomizeSpawnChance, crc);
+    crc = HashValue(MeshInitData.RenderInfo.SpawnChance, crc);
+    crc = HashValue(MeshInitData.RenderInfo.RenderMode, crc);
+    for (const uint32 customIndex : MeshInitData.RenderInfo.RenderModeCustomIndices)
+    {
+        crc = HashValue(customIndex, crc);
+    }
+    for (const FFlexRenderRange& range : MeshInitData.RenderInfo.RenderRanges)
+    {
+        crc = HashValue(range.Start, crc);
+        crc = HashValue(range.End, crc);
+        crc = HashValue(range.Step, crc);
+    }
 
-    return FRotator(vecFromRot.X, vecFromRot.Y, vecFromRot.Z);
+    crc = HashValue(MeshInitData.PlacementInfo.Mode, crc);
+    crc = HashValue(MeshInitData.PlacementInfo.Spacing, crc);
+    crc = HashValue(MeshInitData.PlacementInfo.StartDistance, crc);
+    crc = HashValue(MeshInitData.PlacementInfo.SpacingJitter, crc);
+
+    const bool bGenerateOverlapEvent = MeshInitData.PhysicsInfo.bGenerateOverlapEvent;
+    crc = HashValue(MeshInitData.PhysicsInfo.Collision, crc);
+    crc = HashCombine(crc, GetTypeHash(MeshInitData.PhysicsInfo.CollisionProfileName));
+    crc = HashValue(bGenerateOverlapEvent, crc);
+
+    const bool bCastShadow        = MeshInitData.RenderCostInfo.bCastShadow;
+    const bool bCastDynamicShadow = MeshInitData.RenderCostInfo.bCastDynamicShadow;
+    crc = HashValue(MeshInitData.RenderCostInfo.MinDrawDistance, crc);
+    crc = HashValue(MeshInitData.RenderCostInfo.MaxDrawDistance, crc);
+    crc = HashValue(bCastShadow, crc);
+    crc = HashValue(bCastDynamicShadow, crc);
+    crc = HashValue(MeshInitData.RenderCostInfo.ForcedLodModel, crc);
+    crc = HashValue(MeshInitData.RenderCostInfo.MinLOD, crc);
+    crc = HashValue(MeshInitData.RenderCostInfo.DetailMode, crc);
+
+    for (const UStaticMesh* mergedMesh : MeshInitData.MergeInfo.MergedMeshes)
+    {
+        crc = HashValue(mergedMesh, crc);
+    }
+
+    const bool bAdaptive = MeshInitData.SegmentationInfo.bAdaptive;
+    crc = HashValue(bAdaptive, crc);
+    crc = HashValue(MeshInitData.SegmentationInfo.Tolerance, crc);
+    crc = HashValue(MeshInitData.SegmentationInfo.MaxBendAngle, crc);
+    crc = HashValue(MeshInitData.SegmentationInfo.MaxSegmentLength, crc);
+    crc = HashValue(MeshInitData.SegmentationInfo.MinSegmentLength, crc);
+
+    crc = HashValue(MeshInitData.RotationInfo.CoordinateSystem, crc);
+    crc = HashValue(MeshInitData.RotationInfo.Rotation, crc);
+    crc = HashValue(MeshInitData.RotationInfo.RotationRandomOffset, crc);
+
+    crc = HashValue(MeshInitData.LocationInfo.CoordinateSystem, crc);
+    crc = HashValue(MeshInitData.LocationInfo.Location, crc);
+    crc = HashValue(MeshInitData.LocationInfo.LocationRandomOffset, crc);
+
+    const bool bUseUniformScale             = MeshInitData.ScaleInfo.bUseUniformScale;
+    const bool bUseUniformScaleRandomOffset = MeshInitData.ScaleInfo.bUseUniformScaleRandomOffset;
+    crc = HashValue(bUseUniformScale, crc);
+    crc = HashValue(MeshInitData.ScaleInfo.UniformScale, crc);
+    crc = HashValue(MeshInitData.ScaleInfo.Scale, crc);
+    crc = HashValue(bUseUniformScaleRandomOffset, crc);
+    crc = HashValue(MeshInitData.ScaleInfo.UniformScaleRandomOffset, crc);
+    crc = HashValue(MeshInitData.ScaleInfo.ScaleRandomOffset, crc);
+
+    crc = HashValue(MeshInitData.UpVectorInfo.CoordinateSystem, crc);
+    crc = HashValue(MeshInitData.UpVectorInfo.CustomMeshUpDirection, crc);
+
+    crc = HashCurveInfo(MeshInitData.CurveInfo, crc);
+
+    return crc;
 }
 
-static uint32 GeneratePointHashValue(const USplineComponent* const SplineComp, int32 Index)
+/** Generate random values of a layer for a single spline point or mesh, identified by @param Key */
+static void GenerateRandomOffset(const FSplineMeshInitData& MeshInitData, uint32 Key, FFlexRandomOffsets& OutOffsets)
 {
-    uint32 result = 0;
-    if (SplineComp)
+    const bool bUniformScale = MeshInitData.ScaleInfo.bUseUniformScaleRandomOffset;
+
+    FlexSplineMath::FFlexMathRandomRanges ranges;
+    ranges.Location      = ToMath(MeshInitData.LocationInfo.LocationRandomOffset);
+    ranges.Rotation      = ToMath(MeshInitData.RotationInfo.RotationRandomOffset);
+    ranges.Scale         = ToMath(bUniformScale
+                                  ? FVector(MeshInitData.ScaleInfo.UniformScaleRandomOffset)
+                                  : MeshInitData.ScaleInfo.ScaleRandomOffset);
+    ranges.bUniformScale = bUniformScale;
+
+    FlexSplineMath::FFlexMathRandomOffsets offsets;
+    FlexSplineMath::GenerateRandomOffset(ranges, Key, offsets);
+    OutOffsets.Location  = FromMath(offsets.Location);
+    OutOffsets.Rotation  = FromMath(offsets.Rotation);
+    OutOffsets.Scale     = FromMath(offsets.Scale);
+    OutOffsets.SpawnRoll = offsets.SpawnRoll;
+}
+
+/** Generate random values of all points in [StartIndex, EndIndex) of a layer, keyed on layer and point identifiers */
+static void GenerateRandomOffsets(FSplineMeshInitData& MeshInitData, const TArray<int32>& PointIDs, int32 StartIndex, int32 EndIndex)
+{
+    for (int32 index = StartIndex; index < EndIndex; index++)
     {
-        const auto location = SplineComp->GetLocationAtSplinePoint(Index, LocalSpace);
-        result = GetTypeHash(location);
+        const uint32 pointKey = CombineRandomKey(MeshInitData.LayerSeed, PointIDs[index]);
+        GenerateRandomOffset(MeshInitData, pointKey, MeshInitData.RandomOffsets[index]);
     }
+}
 
-    return result;
+static float EvaluateCurve(const UCurveFloat* Curve, float Time)
+{
+    return Curve->GetFloatValue(Time);
 }
 
-static float FSeededRand(int32 Seed)
+static FVector EvaluateCurve(const UCurveVector* Curve, float Time)
 {
-    return UKismetMathLibrary::RandomFloatInRangeFromStream(0.f, 1.f, FRandomStream((Seed + 1) * 13));
+    return Curve->GetVectorValue(Time);
+}
+
+/**
+* Sample a single curve channel at all @param Keys, or at the normalized @param Distances if its curve is measured by distance.
+* A layer's own curve replaces the Flex Spline's, @param OutValues stays empty if neither has one
+*/
+template <typename TCurve, typename T, typename TConvert>
+static void SampleCurveChannel(TCurve* FFlexCurveInfo::* Channel, const FFlexCurveInfo& LayerCurves, const FFlexCurveInfo& ActorCurves,
+                               const TArray<float>& Keys, const TArray<float>& Distances, TArray<T>& OutValues, TConvert Convert)
+{
+    const FFlexCurveInfo& curveInfo = (LayerCurves.*Channel) ? LayerCurves : ActorCurves;
+    const TCurve* curve             = curveInfo.*Channel;
+    const TArray<float>& times      = (curveInfo.Domain == EFlexCurveDomain::Distance) ? Distances : Keys;
+
+    OutValues.Reset();
+    if (curve)
+    {
+        OutValues.SetNumUninitialized(times.Num());
+        for (int32 index = 0; index < times.Num(); index++)
+        {
+            OutValues[index] = Convert(EvaluateCurve(curve, times[index]));
+        }
+    }
 }
 
 static UClass* GetMeshType(EFlexSplineMeshType MeshType)
@@ -107,29 +363,71 @@ static UClass* GetMeshType(EFlexSplineMeshType MeshType)
     return meshClass;
 }
 
-static bool CanRenderFromSpawnChance(const FSplineMeshInitData& MeshInitData, int32 CurrentIndex)
+static bool CanRenderFromRandomSpawnChance(const FSplineMeshInitData& MeshInitData, int32 CurrentIndex)
 {
-    bool result;
-    const auto meshComp     = MeshInitData.MeshComponentsArray[CurrentIndex];
-    const float spawnChance = MeshInitData.RenderInfo.SpawnChance;
-    const int32 spawnSeed   = GetTypeHash(meshComp->GetName()) * spawnChance;
+    return !MeshInitData.RenderInfo.bRandomizeSpawnChance
+        || (MeshInitData.RenderInfo.SpawnChance > MeshInitData.RandomOffsets[CurrentIndex].SpawnRoll);
+}
 
-    if (MeshInitData.RenderInfo.bRandomizeSpawnChance) // Random spawn chance for each point
+/** Hash everything the render rules of a layer are compiled from */
+static uint32 GenerateRenderRuleHash(const FSplineMeshInitData& MeshInitData, bool bLoop, int32 NumSplinePoints)
+{
+    const bool bDistributed = MeshInitData.IsDistributed();
+    uint32 crc = HashValue(NumSplinePoints, 0);
+    crc = HashValue(bLoop, crc);
+    crc = HashValue(bDistributed, crc);
+    crc = HashValue(MeshInitData.GeneralInfo, crc);
+
+    const bool bRandomizeSpawnChance = MeshInitData.RenderInfo.bRandomizeSpawnChance;
+    crc = HashValue(bRandomizeSpawnChance, crc);
+    crc = HashValue(MeshInitData.RenderInfo.SpawnChance, crc);
+    crc = HashValue(MeshInitData.RenderInfo.RenderMode, crc);
+    for (const uint32 customIndex : MeshInitData.RenderInfo.RenderModeCustomIndices)
     {
-        result = spawnChance > FSeededRand(spawnSeed);
+        crc = HashValue(customIndex, crc);
     }
-    else                                               // Accumulated spawn chance for each point
+    for (const FFlexRenderRange& range : MeshInitData.RenderInfo.RenderRanges)
     {
-        // Compare index-spawn-chance-ratio and see if it has changed from ratio of last index
-        const float interval     = 1.f / FMath::Clamp(spawnChance, 0.00001f, 1.f);
-        const int32 currentRatio = static_cast<int32>(CurrentIndex / interval);
-        const int32 lastRatio    = (CurrentIndex <= 0)
-                                 ? (spawnChance > 0.f ? 1 : 0) // edge case first index
-                                 : (static_cast<int32>(((CurrentIndex - 1) / interval)));
-        result = (currentRatio != lastRatio);
+        crc = HashValue(range.Start, crc);
+        crc = HashValue(range.End, crc);
+        crc = HashValue(range.Step, crc);
     }
 
-    return result;
+    return crc;
+}
+
+/**
+* Compile activity, looping, render mode and accumulated spawn chance of a layer into @param OutMask.
+* Random spawn chance depends on point identifiers and is applied separately
+*/
+static void CompileRenderRules(const FSplineMeshInitData& MeshInitData, bool bLoop, int32 NumSplinePoints, TBitArray<>& OutMask)
+{
+    OutMask.Init(false, NumSplinePoints);
+    if (!TEST_BIT(MeshInitData.GeneralInfo, EFlexGeneralFlags::Active))
+    {
+        return;
+    }
+
+    const FFlexRenderInfo& renderInfo = MeshInitData.RenderInfo;
+    const TArray<uint32> customIndices = renderInfo.RenderModeCustomIndices.Array();
+
+    FlexSplineMath::FFlexMathRenderMode mode;
+    mode.bHead            = TEST_BIT(renderInfo.RenderMode, EFlexSplineRenderMode::Head);
+    mode.bMiddle          = TEST_BIT(renderInfo.RenderMode, EFlexSplineRenderMode::Middle);
+    mode.bTail            = TEST_BIT(renderInfo.RenderMode, EFlexSplineRenderMode::Tail);
+    mode.bCustom          = TEST_BIT(renderInfo.RenderMode, EFlexSplineRenderMode::Custom);
+    mode.bRanges          = TEST_BIT(renderInfo.RenderMode, EFlexSplineRenderMode::Ranges);
+    mode.bLoop            = bLoop;
+    mode.SpawnChance      = renderInfo.SpawnChance;
+    mode.CustomIndices    = customIndices.GetData();
+    mode.NumCustomIndices = customIndices.Num();
+    mode.Ranges           = reinterpret_cast<const FlexSplineMath::FFlexMathRenderRange*>(renderInfo.RenderRanges.GetData());
+    mode.NumRanges        = renderInfo.RenderRanges.Num();
+
+    // Accumulated spawn chance only depends on indices. Layers placed by distance apply it per mesh instead
+    mode.bAccumulatedSpawnChance = !renderInfo.bRandomizeSpawnChance && !MeshInitData.IsDistributed();
+
+    FlexSplineMath::CompileRenderMode(mode, NumSplinePoints, OutMask);
 }
 
 static ESplineMeshAxis::Type ToSplineAxis(EFlexSplineAxis FlexSplineAxis)
@@ -137,505 +435,2474 @@ static ESplineMeshAxis::Type ToSplineAxis(EFlexSplineAxis FlexSplineAxis)
     return static_cast<ESplineMeshAxis::Type>( static_cast<uint8>(FlexSplineAxis) );
 }
 
-void DestroyMeshComponent(FSplineMeshInitData& MeshInitData, int32 Index)
+/** Interpolate @param Values at @param Value between the two samples of the ascending @param Samples around it */
+static float SampleTable(const TArray<float>& Samples, const TArray<float>& Values, float Value)
+{
+    const int32 lastIndex = Samples.Num() - 1;
+    if (lastIndex < 0)
+    {
+        return 0.f;
+    }
+    if (Value <= Samples[0])
+    {
+        return Values[0];
+    }
+    if (Value >= Samples[lastIndex])
+    {
+        return Values[lastIndex];
+    }
+
+    // Binary search for the samples around the value: Samples[low] < Value <= Samples[high]
+    int32 low  = 0;
+    int32 high = lastIndex;
+    while (high - low > 1)
+    {
+        const int32 middle = (low + high) / 2;
+        if (Samples[middle] < Value)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle;
+        }
+    }
+
+    const float range = Samples[high] - Samples[low];
+    const float alpha = (range > 0.f) ? ((Value - Samples[low]) / range) : 0.f;
+    return FMath::Lerp(Values[low], Values[high], alpha);
+}
+
+/** Adaptive segments are never split deeper than this, bounding the number of meshes per run */
+static const int32 MaxAdaptiveDepth = 10;
+
+/** Samples per adaptive segment when measuring its deviation from the spline */
+static const int32 AdaptiveErrorSamples = 8;
+
+/**
+* Run of consecutive resolved segments, parametrized by spline point index: key 3.5 is halfway through segment 3.
+* Segment ends are shared with the next segment's start, so the run is continuous in location, roll, scale and offset
+*/
+struct FFlexSegmentRun
+{
+    const TArray<FFlexResolvedSegment>& Segments;
+    const int32 FirstIndex;
+    const int32 LastIndex;
+
+    FFlexSegmentRun(const TArray<FFlexResolvedSegment>& InSegments, int32 InFirstIndex, int32 InLastIndex)
+        : Segments(InSegments)
+        , FirstIndex(InFirstIndex)
+        , LastIndex(InLastIndex)
+    {
+    }
+
+    /** Segment containing @param Key and the position within it. Keys on spline points select the segment before if @param bEnd */
+    const FFlexResolvedSegment& Locate(float Key, bool bEnd, float& OutAlpha) const
+    {
+        int32 index = FMath::Clamp(FMath::FloorToInt(Key), FirstIndex, LastIndex);
+        if (bEnd && index > FirstIndex && Key == static_cast<float>(index))
+        {
+            index--;
+        }
+        OutAlpha = Key - index;
+        return Segments[index];
+    }
+
+    FVector GetLocation(float Key) const
+    {
+        float alpha;
+        const FFlexResolvedSegment& segment = Locate(Key, false, alpha);
+        return FMath::CubicInterp(segment.StartLocation, segment.StartTangent, segment.EndLocation, segment.EndTangent, alpha);
+    }
+
+    /** Derivative with respect to the key. Spline points may have different tangents on either side */
+    FVector GetTangent(float Key, bool bEnd) const
+    {
+        float alpha;
+        const FFlexResolvedSegment& segment = Locate(Key, bEnd, alpha);
+        return FMath::CubicInterpDerivative(segment.StartLocation, segment.StartTangent, segment.EndLocation, segment.EndTangent, alpha);
+    }
+
+    /** Resolved segment covering @param StartKey to @param EndKey, with location, roll, scale and offset taken from the run */
+    FFlexResolvedSegment MakeSegment(float StartKey, float EndKey) const
+    {
+        float startAlpha;
+        float endAlpha;
+        const FFlexResolvedSegment& start = Locate(StartKey, false, startAlpha);
+        const FFlexResolvedSegment& end   = Locate(EndKey, true, endAlpha);
+
+        FFlexResolvedSegment result = start;
+        result.StartLocation = GetLocation(StartKey);
+        result.EndLocation   = GetLocation(EndKey);
+        result.StartTangent  = GetTangent(StartKey, false) * (EndKey - StartKey);
+        result.EndTangent    = GetTangent(EndKey, true) * (EndKey - StartKey);
+        result.StartRoll     = FMath::Lerp(start.StartRoll, start.EndRoll, startAlpha);
+        result.EndRoll       = FMath::Lerp(end.StartRoll, end.EndRoll, endAlpha);
+        result.StartScale    = FMath::Lerp(start.StartScale, start.EndScale, startAlpha);
+        result.EndScale      = FMath::Lerp(end.StartScale, end.EndScale, endAlpha);
+        result.StartOffset   = FMath::Lerp(start.StartOffset, start.EndOffset, startAlpha);
+        result.EndOffset     = FMath::Lerp(end.StartOffset, end.EndOffset, endAlpha);
+        return result;
+    }
+};
+
+/** Can @param Next continue a run ending in @param Previous, without changing what either of them looks like? */
+static bool CanJoinSegments(const FFlexResolvedSegment& Previous, const FFlexResolvedSegment& Next)
+{
+    return Previous.EndLocation.Equals(Next.StartLocation)
+        && Previous.Location.Equals(Next.Location)
+        && Previous.Rotation.Equals(Next.Rotation)
+        && Previous.Scale.Equals(Next.Scale)
+        && Previous.UpDirection.Equals(Next.UpDirection)
+        && FMath::IsNearlyEqual(Previous.EndRoll, Next.StartRoll)
+        && Previous.EndScale.Equals(Next.StartScale)
+        && Previous.EndOffset.Equals(Next.StartOffset);
+}
+
+/** Split @param StartKey to @param EndKey of @param Run recursively until every piece satisfies @param Info */
+static void SubdivideRun(const FFlexSegmentRun& Run, float StartKey, float EndKey, const FFlexSegmentationInfo& Info,
+                         int32 Depth, TArray<FFlexResolvedSegment>& OutSegments)
+{
+    const FFlexResolvedSegment segment = Run.MakeSegment(StartKey, EndKey);
+
+    // Compare spline and spline mesh at evenly spaced samples, measuring length on the way
+    float error          = 0.f;
+    float length         = 0.f;
+    FVector lastLocation = segment.StartLocation;
+    for (int32 sampleIndex = 1; sampleIndex <= AdaptiveErrorSamples; sampleIndex++)
+    {
+        const float alpha          = static_cast<float>(sampleIndex) / AdaptiveErrorSamples;
+        const FVector location     = Run.GetLocation(FMath::Lerp(StartKey, EndKey, alpha));
+        const FVector meshLocation = FMath::CubicInterp(segment.StartLocation, segment.StartTangent, segment.EndLocation, segment.EndTangent, alpha);
+        error                      = FMath::Max(error, FVector::Dist(location, meshLocation));
+        length                    += FVector::Dist(lastLocation, location);
+        lastLocation               = location;
+    }
+
+    const float bendCos = FVector::DotProduct(segment.StartTangent.GetSafeNormal(), segment.EndTangent.GetSafeNormal());
+    const bool bFits    = (error <= Info.Tolerance)
+                       && (bendCos >= FMath::Cos(FMath::DegreesToRadians(Info.MaxBendAngle)))
+                       && (Info.MaxSegmentLength <= 0.f || length <= Info.MaxSegmentLength);
+
+    if (bFits || Depth >= MaxAdaptiveDepth || length < 2.f * Info.MinSegmentLength)
+    {
+        OutSegments.Add(segment);
+        return;
+    }
+
+    // Split at the spline point closest to the middle, so authored points keep their exact roll and scale
+    const float midKey   = 0.5f * (StartKey + EndKey);
+    const float pointKey = FMath::RoundToFloat(midKey);
+    const bool bOnPoint  = (pointKey > StartKey) && (pointKey < EndKey);
+    const float splitKey = bOnPoint ? pointKey : midKey;
+    SubdivideRun(Run, StartKey, splitKey, Info, Depth + 1, OutSegments);
+    SubdivideRun(Run, splitKey, EndKey, Info, Depth + 1, OutSegments);
+}
+
+/** Log phase timings of the last construction of the slowest Flex Splines in @param World */
+static void DumpSlowestFlexSplines(const TArray<FString>& Args, UWorld* World)
+{
+    const int32 maxEntries = (Args.Num() > 0) ? FMath::Max(1, FCString::Atoi(*Args[0])) : 10;
+
+    TArray<AFlexSplineActor*> flexSplines;
+    for (TActorIterator<AFlexSplineActor> flexSplineIt(World); flexSplineIt; ++flexSplineIt)
+    {
+        flexSplines.Add(*flexSplineIt);
+    }
+    flexSplines.Sort([](const AFlexSplineActor& A, const AFlexSplineActor& B)
+    {
+        return A.GetLastConstructionTimings().GetTotal() > B.GetLastConstructionTimings().GetTotal();
+    });
+
+    UE_LOG(FlexLog, Display, TEXT("Slowest %d of %d Flex Splines, by their last construction:"), FMath::Min(maxEntries, flexSplines.Num()), flexSplines.Num());
+    for (int32 i = 0; i < flexSplines.Num() && i < maxEntries; ++i)
+    {
+        const FFlexConstructionTimings& timings = flexSplines[i]->GetLastConstructionTimings();
+        UE_LOG(FlexLog, Display, TEXT("%s: %.3f ms, %d points, %d overrides, %d layers, %d dirty, %d updated, %d created, %d reused"),
+            *flexSplines[i]->GetName(), timings.GetTotal() * 1000.0, timings.NumSplinePoints, timings.NumPointOverrides, timings.NumLayers,
+            timings.NumDirtySegments, timings.NumUpdatedSegments, timings.NumCreatedComponents, timings.NumReusedComponents);
+        UE_LOG(FlexLog, Display, TEXT("    Layers %.3f, Frames %.3f, Diff %.3f, Dirty %.3f, Resolve %.3f, Prepare %.3f, Update %.3f ms"),
+            timings.GatherLayers * 1000.0, timings.SplineFrames * 1000.0, timings.PointDiff * 1000.0, timings.DirtyTracking * 1000.0,
+            timings.ResolveSegments * 1000.0, timings.PrepareComponents * 1000.0, timings.UpdateComponents * 1000.0);
+    }
+}
+
+/** Rebuild all Flex Splines in @param World, e.g. to profile a full construction with "stat FlexSpline" */
+static void RebuildAllFlexSplines(const TArray<FString>& Args, UWorld* World)
 {
-    WeakStaticMeshComp mesh = MeshInitData.MeshComponentsArray[Index];
-    if (mesh.IsValid())
+    for (TActorIterator<AFlexSplineActor> flexSplineIt(World); flexSplineIt; ++flexSplineIt)
     {
-        mesh->DestroyComponent();
+        flexSplineIt->Rebuild();
     }
-    MeshInitData.MeshComponentsArray.RemoveAt(Index);
 }
 
+static FAutoConsoleCommandWithWorldAndArgs DumpSlowestCommand(
+    TEXT("flexspline.DumpSlowest"),
+    TEXT("Log phase timings of the last construction of the slowest Flex Splines. Optional argument: Number of Flex Splines, 10 by default"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&DumpSlowestFlexSplines));
+
+static FAutoConsoleCommandWithWorldAndArgs RebuildAllCommand(
+    TEXT("flexspline.RebuildAll"),
+    TEXT("Rebuild all Flex Splines of the world"),
+    FConsoleCommandWithWorldAndArgsDelegate::CreateStatic(&RebuildAllFlexSplines));
+
 
 //////////////////////////////////////////////////////////////////////////
 // STRUCT FUNCTIONS
-FSplineMeshInitData::~FSplineMeshInitData()
+void FFlexOverrideMask::SetNum(int32 NumPoints)
+{
+    const int32 numWords = (NumPoints + 31) >> 5;
+    Words.SetNumZeroed(numWords);
+    if (NumPoints & 31)
+    {
+        Words.Last() &= (1u << (NumPoints & 31)) - 1;
+    }
+    RebuildRanks();
+}
+
+void FFlexOverrideMask::Set(int32 Index)
 {
-    for (auto splineMesh : MeshComponentsArray)
+    const int32 word = Index >> 5;
+    const uint32 bit = 1u << (Index & 31);
+    if (!(Words[word] & bit))
     {
-        if (splineMesh.IsValid())
+        Words[word] |= bit;
+        for (int32 index = word + 1; index < Ranks.Num(); index++)
         {
-            splineMesh->ConditionalBeginDestroy();
+            Ranks[index]++;
         }
     }
+}
 
-    for (auto arrow : ArrowSplineUpIndicatorArray)
+void FFlexOverrideMask::Clear(int32 Index)
+{
+    const int32 word = Index >> 5;
+    const uint32 bit = 1u << (Index & 31);
+    if (Words[word] & bit)
     {
-        if (arrow.IsValid())
+        Words[word] &= ~bit;
+        for (int32 index = word + 1; index < Ranks.Num(); index++)
         {
-            arrow->ConditionalBeginDestroy();
+            Ranks[index]--;
         }
     }
 }
 
+void FFlexOverrideMask::RebuildRanks()
+{
+    Ranks.SetNumUninitialized(Words.Num());
+    int32 rank = 0;
+    for (int32 index = 0; index < Words.Num(); index++)
+    {
+        Ranks[index] = rank;
+        rank += CountBits(Words[index]);
+    }
+}
 
-//////////////////////////////////////////////////////////////////////////
-// CONSTRUCTOR + BASE INTERFACE + GETTER
-AFlexSplineActor::AFlexSplineActor()
-    : Super()
-    , CollisionActive(EFlexGlobalConfigType::Nowhere)
-    , Synchronize(EFlexGlobalConfigType::Custom)
-    , Loop(EFlexGlobalConfigType::Custom)
-    , bShowPointNumbers(false)
-    , PointNumberSize(125.f)
-    , UpDirectionArrowSize(3.f)
-    , UpDirectionArrowOffset(25.f)
-    , TextRenderColor(FColor::Cyan)
+bool FFlexOverrideMask::Serialize(FArchive& Ar)
 {
-    PrimaryActorTick.bCanEverTick = false;
+    Ar << Words;
+    if (Ar.IsLoading())
+    {
+        RebuildRanks();
+    }
+    return true;
+}
+
+/** Set the value of point @param Index of a masked channel, a value equal to @param Default removes its override */
+template <typename T>
+static void SetPointOverride(FFlexOverrideMask& Mask, TArray<T>& Values, int32 Index, const T& Value, const T& Default)
+{
+    const int32 packedIndex = Mask.GetPackedIndex(Index);
+    if (Value == Default)
+    {
+        if (packedIndex != INDEX_NONE)
+        {
+            Values.RemoveAt(packedIndex, 1, false);
+            Mask.Clear(Index);
+        }
+    }
+    else if (packedIndex != INDEX_NONE)
+    {
+        Values[packedIndex] = Value;
+    }
+    else
+    {
+        // Points before this one keep their packed positions
+        Mask.Set(Index);
+        Values.Insert(Value, Mask.GetPackedIndex(Index));
+    }
+}
+
+/** Resize a masked channel to @param NewNum points, values of removed points are dropped */
+template <typename T>
+static void ResizeOverrides(FFlexOverrideMask& Mask, TArray<T>& Values, int32 NewNum)
+{
+    Mask.SetNum(NewNum);
+    Values.SetNum(Mask.NumSet(), false);
+}
+
+/** Reorder a masked channel, see FFlexPointDataChannels::Remap */
+template <typename T>
+static void RemapOverrides(FFlexOverrideMask& Mask, TArray<T>& Values, const TArray<int32>& SourceIndices)
+{
+    FFlexOverrideMask remappedMask;
+    remappedMask.Words.SetNumZeroed((SourceIndices.Num() + 31) >> 5);
+    TArray<T> remappedValues;
+    for (int32 index = 0; index < SourceIndices.Num(); index++)
+    {
+        const int32 packedIndex = (SourceIndices[index] != INDEX_NONE) ? Mask.GetPackedIndex(SourceIndices[index]) : INDEX_NONE;
+        if (packedIndex != INDEX_NONE)
+        {
+            remappedMask.Words[index >> 5] |= 1u << (index & 31);
+            remappedValues.Add(Values[packedIndex]);
+        }
+    }
+    remappedMask.RebuildRanks();
+    Mask   = MoveTemp(remappedMask);
+    Values = MoveTemp(remappedValues);
+}
+
+/** Repair a masked channel of @param NumPoints points after loading. Values saved for every point are compacted */
+template <typename T>
+static void FixupOverrides(FFlexOverrideMask& Mask, TArray<T>& Values, int32 NumPoints, const T& Default)
+{
+    if (Mask.Words.Num() == 0 && Values.Num() == NumPoints)
+    {
+        TArray<T> denseValues = MoveTemp(Values);
+        Values.Reset();
+        Mask.SetNum(NumPoints);
+        for (int32 index = 0; index < NumPoints; index++)
+        {
+            if (denseValues[index] != Default)
+            {
+                Mask.Words[index >> 5] |= 1u << (index & 31);
+                Values.Add(denseValues[index]);
+            }
+        }
+        Mask.RebuildRanks();
+        return;
+    }
+
+    Mask.SetNum(NumPoints);
+    if (Values.Num() != Mask.NumSet())
+    {
+        UE_LOG(FlexLog, Warning, TEXT("Point data overrides do not match their mask, resetting them to defaults"));
+        Mask.Words.Empty();
+        Mask.SetNum(NumPoints);
+        Values.Empty();
+    }
+}
+
+/** Resize a single per-point channel of FFlexPointDataChannels, filling new entries with @param Default */
+template <typename T>
+static void ResizeChannel(TArray<T>& Channel, int32 NewNum, const T& Default)
+{
+    const int32 oldNum = Channel.Num();
+    Channel.SetNumUninitialized(NewNum);
+    for (int32 index = oldNum; index < NewNum; index++)
+    {
+        Channel[index] = Default;
+    }
+}
+
+/** Reorder a single per-point channel of FFlexPointDataChannels, see FFlexPointDataChannels::Remap */
+template <typename T>
+static void RemapChannel(TArray<T>& Channel, const TArray<int32>& SourceIndices, const T& Default)
+{
+    TArray<T> remapped;
+    remapped.SetNumUninitialized(SourceIndices.Num());
+    for (int32 index = 0; index < SourceIndices.Num(); index++)
+    {
+        remapped[index] = (SourceIndices[index] != INDEX_NONE) ? Channel[SourceIndices[index]] : Default;
+    }
+    Channel = MoveTemp(remapped);
+}
+
+/** Flags of a default spline point */
+static uint8 GetDefaultPointFlags(const FSplinePointData& Point)
+{
+    uint8 flags = 0;
+    if (Point.bSynchroniseWithPrevious)
+    {
+        SET_BIT(flags, EFlexPointFlags::SynchroniseWithPrevious);
+    }
+    return flags;
+}
+
+void FFlexPointDataChannels::SetStartRoll(int32 Index, float Value)
+{
+    SetPointOverride(StartRollMask, StartRolls, Index, Value, 0.f);
+}
+
+void FFlexPointDataChannels::SetEndRoll(int32 Index, float Value)
+{
+    SetPointOverride(EndRollMask, EndRolls, Index, Value, 0.f);
+}
+
+void FFlexPointDataChannels::SetStartScale(int32 Index, const FVector2D& Value)
+{
+    SetPointOverride(StartScaleMask, StartScales, Index, Value, FVector2D(1.f, 1.f));
+}
+
+void FFlexPointDataChannels::SetEndScale(int32 Index, const FVector2D& Value)
+{
+    SetPointOverride(EndScaleMask, EndScales, Index, Value, FVector2D(1.f, 1.f));
+}
+
+void FFlexPointDataChannels::SetStartOffset(int32 Index, const FVector2D& Value)
+{
+    SetPointOverride(StartOffsetMask, StartOffsets, Index, Value, FVector2D::ZeroVector);
+}
+
+void FFlexPointDataChannels::SetEndOffset(int32 Index, const FVector2D& Value)
+{
+    SetPointOverride(EndOffsetMask, EndOffsets, Index, Value, FVector2D::ZeroVector);
+}
+
+void FFlexPointDataChannels::SetUpDirection(int32 Index, const FVector& Value)
+{
+    SetPointOverride(UpDirectionMask, UpDirections, Index, Value, FVector::ZeroVector);
+}
+
+void FFlexPointDataChannels::SetSMLocationOffset(int32 Index, const FVector& Value)
+{
+    SetPointOverride(SMLocationOffsetMask, SMLocationOffsets, Index, Value, FVector::ZeroVector);
+}
+
+void FFlexPointDataChannels::SetSMScale(int32 Index, const FVector& Value)
+{
+    SetPointOverride(SMScaleMask, SMScales, Index, Value, FVector::ZeroVector);
+}
+
+void FFlexPointDataChannels::SetSMRotation(int32 Index, const FRotator& Value)
+{
+    SetPointOverride(SMRotationMask, SMRotations, Index, Value, FRotator::ZeroRotator);
+}
+
+void FFlexPointDataChannels::SetSynchroniseWithPrevious(int32 Index, bool bSynchronise)
+{
+    if (bSynchronise)
+    {
+        SET_BIT(Flags[Index], EFlexPointFlags::SynchroniseWithPrevious);
+    }
+    else
+    {
+        CLEAR_BIT(Flags[Index], EFlexPointFlags::SynchroniseWithPrevious);
+    }
+}
+
+void FFlexPointDataChannels::SetNum(int32 NewNum)
+{
+    const FSplinePointData defaults;
+    ResizeOverrides(StartRollMask,        StartRolls,        NewNum);
+    ResizeOverrides(EndRollMask,          EndRolls,          NewNum);
+    ResizeOverrides(StartScaleMask,       StartScales,       NewNum);
+    ResizeOverrides(EndScaleMask,         EndScales,         NewNum);
+    ResizeOverrides(StartOffsetMask,      StartOffsets,      NewNum);
+    ResizeOverrides(EndOffsetMask,        EndOffsets,        NewNum);
+    ResizeOverrides(UpDirectionMask,      UpDirections,      NewNum);
+    ResizeOverrides(SMLocationOffsetMask, SMLocationOffsets, NewNum);
+    ResizeOverrides(SMScaleMask,          SMScales,          NewNum);
+    ResizeOverrides(SMRotationMask,       SMRotations,       NewNum);
+    ResizeChannel(Flags,         NewNum, GetDefaultPointFlags(defaults));
+    ResizeChannel(PointIDs,      NewNum, defaults.PointID);
+    ResizeChannel(LastLocations, NewNum, defaults.LastLocation);
+}
+
+void FFlexPointDataChannels::Remap(const TArray<int32>& SourceIndices)
+{
+    const FSplinePointData defaults;
+    RemapOverrides(StartRollMask,        StartRolls,        SourceIndices);
+    RemapOverrides(EndRollMask,          EndRolls,          SourceIndices);
+    RemapOverrides(StartScaleMask,       StartScales,       SourceIndices);
+    RemapOverrides(EndScaleMask,         EndScales,         SourceIndices);
+    RemapOverrides(StartOffsetMask,      StartOffsets,      SourceIndices);
+    RemapOverrides(EndOffsetMask,        EndOffsets,        SourceIndices);
+    RemapOverrides(UpDirectionMask,      UpDirections,      SourceIndices);
+    RemapOverrides(SMLocationOffsetMask, SMLocationOffsets, SourceIndices);
+    RemapOverrides(SMScaleMask,          SMScales,          SourceIndices);
+    RemapOverrides(SMRotationMask,       SMRotations,       SourceIndices);
+    RemapChannel(Flags,         SourceIndices, GetDefaultPointFlags(defaults));
+    RemapChannel(PointIDs,      SourceIndices, defaults.PointID);
+    RemapChannel(LastLocations, SourceIndices, defaults.LastLocation);
+}
+
+FSplinePointData FFlexPointDataChannels::GetPoint(int32 Index) const
+{
+    FSplinePointData point;
+    point.StartRoll                = GetStartRoll(Index);
+    point.EndRoll                  = GetEndRoll(Index);
+    point.StartScale               = GetStartScale(Index);
+    point.EndScale                 = GetEndScale(Index);
+    point.StartOffset              = GetStartOffset(Index);
+    point.EndOffset                = GetEndOffset(Index);
+    point.CustomPointUpDirection   = GetUpDirection(Index);
+    point.bSynchroniseWithPrevious = GetSynchroniseWithPrevious(Index);
+    point.SMLocationOffset         = GetSMLocationOffset(Index);
+    point.SMScale                  = GetSMScale(Index);
+    point.SMRotation               = GetSMRotation(Index);
+    point.PointID                  = PointIDs[Index];
+    point.LastLocation             = LastLocations[Index];
+    return point;
+}
+
+void FFlexPointDataChannels::SetPoint(int32 Index, const FSplinePointData& Point)
+{
+    SetStartRoll(Index, Point.StartRoll);
+    SetEndRoll(Index, Point.EndRoll);
+    SetStartScale(Index, Point.StartScale);
+    SetEndScale(Index, Point.EndScale);
+    SetStartOffset(Index, Point.StartOffset);
+    SetEndOffset(Index, Point.EndOffset);
+    SetUpDirection(Index, Point.CustomPointUpDirection);
+    SetSMLocationOffset(Index, Point.SMLocationOffset);
+    SetSMScale(Index, Point.SMScale);
+    SetSMRotation(Index, Point.SMRotation);
+    Flags[Index]         = GetDefaultPointFlags(Point);
+    PointIDs[Index]      = Point.PointID;
+    LastLocations[Index] = Point.LastLocation;
+}
+
+void FFlexPointDataChannels::FixupChannels()
+{
+    const FSplinePointData defaults;
+    const int32 numPoints = FMath::Max3(Flags.Num(), PointIDs.Num(), LastLocations.Num());
+    ResizeChannel(Flags,         numPoints, GetDefaultPointFlags(defaults));
+    ResizeChannel(PointIDs,      numPoints, defaults.PointID);
+    ResizeChannel(LastLocations, numPoints, defaults.LastLocation);
+
+    FixupOverrides(StartRollMask,        StartRolls,        numPoints, defaults.StartRoll);
+    FixupOverrides(EndRollMask,          EndRolls,          numPoints, defaults.EndRoll);
+    FixupOverrides(StartScaleMask,       StartScales,       numPoints, defaults.StartScale);
+    FixupOverrides(EndScaleMask,         EndScales,         numPoints, defaults.EndScale);
+    FixupOverrides(StartOffsetMask,      StartOffsets,      numPoints, defaults.StartOffset);
+    FixupOverrides(EndOffsetMask,        EndOffsets,        numPoints, defaults.EndOffset);
+    FixupOverrides(UpDirectionMask,      UpDirections,      numPoints, defaults.CustomPointUpDirection);
+    FixupOverrides(SMLocationOffsetMask, SMLocationOffsets, numPoints, defaults.SMLocationOffset);
+    FixupOverrides(SMScaleMask,          SMScales,          numPoints, defaults.SMScale);
+    FixupOverrides(SMRotationMask,       SMRotations,       numPoints, defaults.SMRotation);
+}
+
+int32 FFlexPointDataChannels::GetNumOverrides() const
+{
+    return StartRolls.Num() + EndRolls.Num() + StartScales.Num() + EndScales.Num() + StartOffsets.Num() + EndOffsets.Num()
+        + UpDirections.Num() + SMLocationOffsets.Num() + SMScales.Num() + SMRotations.Num();
+}
+
+/** Memory of a masked channel, its ranks included */
+template <typename T>
+static SIZE_T GetOverridesAllocatedSize(const FFlexOverrideMask& Mask, const TArray<T>& Values)
+{
+    return Mask.Words.GetAllocatedSize() + Mask.Ranks.GetAllocatedSize() + Values.GetAllocatedSize();
+}
+
+SIZE_T FFlexPointDataChannels::GetAllocatedSize() const
+{
+    return GetOverridesAllocatedSize(StartRollMask, StartRolls) + GetOverridesAllocatedSize(EndRollMask, EndRolls)
+        + GetOverridesAllocatedSize(StartScaleMask, StartScales) + GetOverridesAllocatedSize(EndScaleMask, EndScales)
+        + GetOverridesAllocatedSize(StartOffsetMask, StartOffsets) + GetOverridesAllocatedSize(EndOffsetMask, EndOffsets)
+        + GetOverridesAllocatedSize(UpDirectionMask, UpDirections)
+        + GetOverridesAllocatedSize(SMLocationOffsetMask, SMLocationOffsets) + GetOverridesAllocatedSize(SMScaleMask, SMScales)
+        + GetOverridesAllocatedSize(SMRotationMask, SMRotations)
+        + Flags.GetAllocatedSize() + PointIDs.GetAllocatedSize() + LastLocations.GetAllocatedSize();
+}
+
+float FFlexArcLengthTable::GetKeyAtDistance(float Distance) const
+{
+    return SampleTable(Distances, Keys, Distance);
+}
+
+float FFlexArcLengthTable::GetDistanceAtKey(float Key) const
+{
+    return SampleTable(Keys, Distances, Key);
+}
+
+void FSplineMeshInitData::CopySettings(const FSplineMeshInitData& Source)
+{
+    GeneralInfo      = Source.GeneralInfo;
+    MeshInfo         = Source.MeshInfo;
+    RenderInfo       = Source.RenderInfo;
+    PlacementInfo    = Source.PlacementInfo;
+    PhysicsInfo      = Source.PhysicsInfo;
+    RenderCostInfo   = Source.RenderCostInfo;
+    RotationInfo     = Source.RotationInfo;
+    LocationInfo     = Source.LocationInfo;
+    ScaleInfo        = Source.ScaleInfo;
+    UpVectorInfo     = Source.UpVectorInfo;
+    SegmentationInfo = Source.SegmentationInfo;
+    MergeInfo        = Source.MergeInfo;
+    CurveInfo        = Source.CurveInfo;
+    Initialize();
+}
+
+FSplineMeshInitData::~FSplineMeshInitData()
+{
+    if (InstancedMeshComponent.IsValid())
+    {
+        InstancedMeshComponent->ConditionalBeginDestroy();
+    }
+
+    for (auto& splineMeshPair : MeshComponents)
+    {
+        if (splineMeshPair.Value.IsValid())
+        {
+            splineMeshPair.Value->ConditionalBeginDestroy();
+        }
+    }
+
+    for (WeakStaticMeshComp& adaptiveMesh : AdaptiveMeshComponents)
+    {
+        if (adaptiveMesh.IsValid())
+        {
+            adaptiveMesh->ConditionalBeginDestroy();
+        }
+    }
+
+    for (WeakStaticMeshComp& distributedMesh : DistributedMeshComponents)
+    {
+        if (distributedMesh.IsValid())
+        {
+            distributedMesh->ConditionalBeginDestroy();
+        }
+    }
+
+    for (WeakStaticMeshComp& mergedMesh : MergedMeshComponents)
+    {
+        if (mergedMesh.IsValid())
+        {
+            mergedMesh->ConditionalBeginDestroy();
+        }
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// CONSTRUCTOR + BASE INTERFACE + GETTER
+AFlexSplineActor::AFlexSplineActor()
+    : Super()
+    , CollisionActive(EFlexGlobalConfigType::Nowhere)
+    , Synchronize(EFlexGlobalConfigType::Custom)
+    , Loop(EFlexGlobalConfigType::Custom)
+    , RandomSeed(0)
+    , bTimeSlicedConstruction(false)
+    , LayerPreset(nullptr)
+#if WITH_EDITORONLY_DATA
+    , bShowPointNumbers(false)
+    , PointNumberSize(125.f)
+    , UpDirectionArrowSize(3.f)
+    , UpDirectionArrowOffset(25.f)
+    , TextRenderColor(FColor::Cyan)
+#endif
+    , NextLayerID(0)
+    , NextPointID(0)
+    , GlobalSettingsHash(0)
+    , bHasBakedLayout(false)
+    , NextPendingSegment(0)
+    , ReportedPointDataMemory(0)
+    , ReportedLayerDataMemory(0)
+{
+    PrimaryActorTick.bCanEverTick = false;
+
+    // Spline Component
+    SplineComponent = CreateDefaultSubobject<USplineComponent>(TEXT("Spline"));
+    SplineComponent->SetMobility(EComponentMobility::Static);
+    RootComponent = SplineComponent;
+
+#if WITH_EDITORONLY_DATA
+    // Point numbers and up directions are drawn by its visualizer, cooked builds never create it
+    DebugComponent = CreateEditorOnlyDefaultSubobject<UFlexSplineDebugComponent>(TEXT("DebugVisualization"));
+#endif
+}
+
+void AFlexSplineActor::PostLoad()
+{
+    Super::PostLoad();
+
+    PointData.FixupChannels();
+
+    // Point data used to be stored per point. Move it into channels, appended in case both were saved
+    if (PointDataArray.Num() > 0)
+    {
+        const int32 firstIndex = PointData.Num();
+        PointData.SetNum(firstIndex + PointDataArray.Num());
+        for (int32 index = 0; index < PointDataArray.Num(); index++)
+        {
+            // Point numbers used to be drawn by a text render component per spline point
+            FSplinePointData& legacyPoint = PointDataArray[index];
+            if (legacyPoint.IndexTextRenderer_DEPRECATED)
+            {
+                legacyPoint.IndexTextRenderer_DEPRECATED->DestroyComponent();
+                legacyPoint.IndexTextRenderer_DEPRECATED = nullptr;
+            }
+            PointData.SetPoint(firstIndex + index, legacyPoint);
+        }
+        PointDataArray.Empty();
+    }
+}
+
+void AFlexSplineActor::BeginDestroy()
+{
+#if WITH_EDITOR
+    if (PackageSavedHandle.IsValid())
+    {
+        UPackage::PackageSavedEvent.Remove(PackageSavedHandle);
+        PackageSavedHandle.Reset();
+    }
+#endif
+    UpdateMemoryStats(true);
+    Super::BeginDestroy();
+}
+
+#if WITH_EDITOR
+void AFlexSplineActor::PreSave(const ITargetPlatform* TargetPlatform)
+{
+    Super::PreSave(TargetPlatform);
+
+    BakedLayers.Empty();
+    bHasBakedLayout = false;
+
+    // Only cooking saves for a target platform
+    if (!TargetPlatform)
+    {
+        return;
+    }
+
+    // Resolve the layout from scratch on a transient duplicate, since the actor may never have been constructed in
+    // the cooker, and cooking from a running editor must leave the live Flex Spline untouched. Point identifiers
+    // assigned by the duplicate are assigned the same way by the first runtime rebuild
+    AFlexSplineActor* bakeSpline = DuplicateObject<AFlexSplineActor>(this, GetTransientPackage());
+    bakeSpline->SetFlags(RF_Transient);
+
+    TBitArray<> dirtySegments;
+    bakeSpline->ResolveLayout(dirtySegments);
+    for (const FSplineMeshInitData* layer : bakeSpline->Layers)
+    {
+        bakeSpline->BakeLayout(*layer, BakedLayers.Add(layer->LayerID));
+    }
+    bakeSpline->MarkPendingKill();
+    bHasBakedLayout = true;
+
+    // Only the root object of a package is told about the end of its save, e.g. the world of a map
+    if (!PackageSavedHandle.IsValid())
+    {
+        PackageSavedHandle = UPackage::PackageSavedEvent.AddUObject(this, &AFlexSplineActor::OnPackageSaved);
+    }
+}
+
+void AFlexSplineActor::OnPackageSaved(const FString& PackageFileName, UObject* Package)
+{
+    if (Package != GetOutermost())
+    {
+        return;
+    }
+
+    UPackage::PackageSavedEvent.Remove(PackageSavedHandle);
+    PackageSavedHandle.Reset();
+    BakedLayers.Empty();
+    bHasBakedLayout = false;
+}
+
+void AFlexSplineActor::BakeLayout(const FSplineMeshInitData& MeshInitData, FFlexBakedLayer& OutBakedLayer) const
+{
+    if (MeshInitData.IsMerged())
+    {
+        // Merged meshes need no placement at all
+    }
+    else if (MeshInitData.IsAdaptive())
+    {
+        OutBakedLayer.Segments = MeshInitData.AdaptiveSegments;
+    }
+    else if (MeshInitData.IsDistributed())
+    {
+        OutBakedLayer.Segments = MeshInitData.DistributedSegments;
+    }
+    else
+    {
+        for (TConstSetBitIterator<> visibleIt(MeshInitData.VisibilityMask); visibleIt; ++visibleIt)
+        {
+            OutBakedLayer.Segments.Add(MeshInitData.ResolvedSegments[visibleIt.GetIndex()]);
+            OutBakedLayer.PointIDs.Add(PointData.PointIDs[visibleIt.GetIndex()]);
+        }
+    }
+}
+#endif
+
+void AFlexSplineActor::OnConstruction(const FTransform& Transform)
+{
+    Super::OnConstruction(Transform);
+
+    // FlexSpline construction for editor builds here
+    ConstructSplineMesh();
+}
+
+void AFlexSplineActor::PreInitializeComponents()
+{
+    Super::PreInitializeComponents();
+
+    // FlexSpline construction for cooked builds here because it has no OnConstrcution. Placed Flex Splines
+    // were resolved during cooking, only those spawned at runtime evaluate their spline
+#if !WITH_EDITOR
+    if (bHasBakedLayout)
+    {
+        ApplyBakedLayout();
+    }
+    else
+    {
+        ConstructSplineMesh();
+    }
+#endif
+}
+
+int32 AFlexSplineActor::GetMeshCountForType(EFlexSplineMeshType MeshType) const
+{
+    int32 count = 0;
+    ForEachLayer([&](const FSplineMeshInitData& MeshInitData)
+    {
+        if ( (MeshInitData.MeshInfo.MeshType == MeshType) && (TEST_BIT(MeshInitData.GeneralInfo, EFlexGeneralFlags::Active)) )
+        {
+            count++;
+        }
+    });
+    return count;
+}
+
+void AFlexSplineActor::Rebuild()
+{
+    ConstructSplineMesh();
+}
+
+bool AFlexSplineActor::IsConstructionPending() const
+{
+    return NextPendingSegment < PendingSegmentOrder.Num();
+}
+
+bool AFlexSplineActor::ProcessPendingSegments(double EndTime)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineProcessPendingSegments);
+
+    // Always make progress, even if the budget is already used up by other Flex Splines
+    FFlexScopedPhaseTimer phaseTimer(LastConstructionTimings.UpdateComponents);
+    int32 numUpdatedSegments   = 0;
+    FSplineMeshInitData* layer = nullptr;
+    while (NextPendingSegment < PendingSegmentOrder.Num())
+    {
+        const FFlexPendingSegment& pending = PendingSegmentOrder[NextPendingSegment++];
+
+        // Layers may have been removed or edited since queuing, their segments are skipped until the next rebuild
+        if (!layer || layer->LayerID != pending.LayerID)
+        {
+            layer = FindLayer(pending.LayerID);
+        }
+        const bool bValidIndex = (pending.Index == INDEX_NONE)
+                              || (layer && layer->PendingSegments.IsValidIndex(pending.Index) && layer->ResolvedSegments.IsValidIndex(pending.Index)
+                                        && PointData.PointIDs.IsValidIndex(pending.Index));
+        if (!layer || !bValidIndex)
+        {
+            continue;
+        }
+
+        FSplineMeshInitData& meshInitData = *layer;
+        if (pending.Index == INDEX_NONE && meshInitData.IsAdaptive())
+        {
+            numUpdatedSegments += UpdateAdaptiveMeshes(meshInitData);
+            meshInitData.bLayerPending = false;
+        }
+        else if (pending.Index == INDEX_NONE && meshInitData.IsDistributed() && !meshInitData.IsInstanced())
+        {
+            numUpdatedSegments += UpdateDistributedMeshes(meshInitData);
+            meshInitData.bLayerPending = false;
+        }
+        else if (pending.Index == INDEX_NONE)
+        {
+            UpdateInstancedMesh(meshInitData);
+            meshInitData.bLayerPending = false;
+        }
+        else
+        {
+            numUpdatedSegments += UpdateMeshComponent(meshInitData, pending.Index) ? 1 : 0;
+            meshInitData.PendingSegments[pending.Index] = false;
+        }
+
+        if (FPlatformTime::Seconds() >= EndTime)
+        {
+            break;
+        }
+    }
+    INC_DWORD_STAT_BY(STAT_FlexSplineSegmentsUpdated, numUpdatedSegments);
+    LastConstructionTimings.NumUpdatedSegments += numUpdatedSegments;
+
+    if (IsConstructionPending())
+    {
+        return false;
+    }
+
+    PendingSegmentOrder.Reset();
+    NextPendingSegment = 0;
+    OnConstructionCompleted.Broadcast(this);
+    return true;
+}
+
+void AFlexSplineActor::NotifySplinePointInserted(int32 Index)
+{
+    Modify();
+
+    // Identifiers out of sync with the spline are worse than none, location matching takes over until the next rebuild
+    if (Index < 0 || Index > SplinePointIDs.Num())
+    {
+        SplinePointIDs.Empty();
+        return;
+    }
+    SplinePointIDs.Insert(INDEX_NONE, Index);
+}
+
+void AFlexSplineActor::NotifySplinePointRemoved(int32 Index)
+{
+    Modify();
+
+    if (!SplinePointIDs.IsValidIndex(Index))
+    {
+        SplinePointIDs.Empty();
+        return;
+    }
+    SplinePointIDs.RemoveAt(Index);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// FLEX SPLINE FUNCTIONALITY
+void AFlexSplineActor::ConstructSplineMesh()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineConstructSplineMesh);
+
+    // Resolve all placements first, then push them to components, which only exist for visible points
+    TBitArray<> dirtySegments;
+    ResolveLayout(dirtySegments);
+    {
+        FFlexScopedPhaseTimer phaseTimer(LastConstructionTimings.PrepareComponents);
+        PrepareMeshComponents();
+    }
+
+    if (ShouldTimeSliceConstruction())
+    {
+        QueuePendingSegments(dirtySegments);
+    }
+    else
+    {
+        {
+            FFlexScopedPhaseTimer phaseTimer(LastConstructionTimings.UpdateComponents);
+            UpdateMeshComponents(dirtySegments);
+        }
+        OnConstructionCompleted.Broadcast(this);
+    }
+}
+
+void AFlexSplineActor::ResolveLayout(TBitArray<>& OutDirtySegments)
+{
+    LastConstructionTimings = FFlexConstructionTimings();
+    {
+        FFlexScopedPhaseTimer phaseTimer(LastConstructionTimings.GatherLayers);
+        InitializeNewMeshData();
+        GatherLayers();
+    }
+    {
+        FFlexScopedPhaseTimer phaseTimer(LastConstructionTimings.SplineFrames);
+        UpdateSplineFrames();
+        UpdateArcLengthTable();
+    }
+
+    // Match spline points against point data of the last rebuild. Data of surviving points is carried over,
+    // data of inserted and deleted points is added or removed in a single pass
+    {
+        FFlexScopedPhaseTimer phaseTimer(LastConstructionTimings.PointDiff);
+        FFlexPointDiff pointDiff;
+        DiffSplinePoints(pointDiff);
+        ApplyPointDiff(pointDiff);
+        UpdatePointData();
+    }
+
+    // Find out which segments and layers are affected by changes since the last rebuild
+    {
+        FFlexScopedPhaseTimer phaseTimer(LastConstructionTimings.DirtyTracking);
+        GatherDirtySegments(OutDirtySegments);
+        LastConstructionTimings.NumDirtySegments = OutDirtySegments.CountSetBits();
+    }
+
+    // Resolve placements of all dirty segments in parallel
+    {
+        FFlexScopedPhaseTimer phaseTimer(LastConstructionTimings.ResolveSegments);
+        ResolveSegments(OutDirtySegments);
+    }
+
+    LastConstructionTimings.NumSplinePoints   = PointData.Num();
+    LastConstructionTimings.NumPointOverrides = PointData.GetNumOverrides();
+    LastConstructionTimings.NumLayers         = Layers.Num();
+    UpdateMemoryStats();
+}
+
+void AFlexSplineActor::ApplyBakedLayout()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineApplyBakedLayout);
+
+    // Layers are found by the identifiers their layout was baked under, preset layers need their instances first
+    GatherLayers();
+
+    for (FSplineMeshInitData* layer : Layers)
+    {
+        FSplineMeshInitData& meshInitData = *layer;
+        if (meshInitData.IsMerged())
+        {
+            UpdateMergedMeshes(meshInitData);
+            continue;
+        }
+        const FFlexBakedLayer* bakedLayer = BakedLayers.Find(meshInitData.LayerID);
+        if (!bakedLayer || bakedLayer->Segments.Num() == 0)
+        {
+            continue;
+        }
+
+        if (meshInitData.IsInstanced())
+        {
+            UHierarchicalInstancedStaticMeshComponent* instancedMesh = CreateInstancedMeshComponent(meshInitData);
+            UpdateMeshSettings(meshInitData, instancedMesh);
+            for (const FFlexResolvedSegment& segment : bakedLayer->Segments)
+            {
+                instancedMesh->AddInstance(FTransform(segment.Rotation, segment.Location, segment.Scale));
+            }
+        }
+        else
+        {
+            UClass* meshType = GetMeshType(meshInitData.MeshInfo.MeshType);
+            for (int32 segmentIndex = 0; segmentIndex < bakedLayer->Segments.Num(); segmentIndex++)
+            {
+                const FFlexResolvedSegment& segment = bakedLayer->Segments[segmentIndex];
+                UStaticMeshComponent* mesh          = CreateMeshComponent(meshType);
+                UpdateMeshSettings(meshInitData, mesh);
+                if (meshInitData.IsAdaptive())
+                {
+                    meshInitData.AdaptiveMeshComponents.Add(mesh);
+                }
+                else if (meshInitData.IsDistributed())
+                {
+                    meshInitData.DistributedMeshComponents.Add(mesh);
+                }
+                else
+                {
+                    meshInitData.MeshComponents.Add(bakedLayer->PointIDs[segmentIndex], mesh);
+                }
+
+                if (meshType == SplineMeshClass)
+                {
+                    UpdateSplineMesh(meshInitData, CastChecked<USplineMeshComponent>(mesh), segment);
+                }
+                else if (meshType == StaticMeshClass)
+                {
+                    UpdateStaticMesh(meshInitData, mesh, segment);
+                }
+            }
+        }
+    }
+
+    // Components own their placement from here on. A runtime rebuild resolves everything again,
+    // but finds the components via their point identifier
+    BakedLayers.Empty();
+
+    OnConstructionCompleted.Broadcast(this);
+}
+
+bool AFlexSplineActor::ShouldTimeSliceConstruction() const
+{
+    const UWorld* world = GetWorld();
+    return bTimeSlicedConstruction && world && world->IsGameWorld() && FFlexSplineConstructionManager::IsEnabled();
+}
+
+void AFlexSplineActor::QueuePendingSegments(const TBitArray<>& DirtySegments)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineQueuePendingSegments);
+
+    const int32 numSplinePoints  = DirtySegments.Num();
+    const int32 numDirtySegments = DirtySegments.CountSetBits();
+
+    // Segments still pending from an earlier rebuild stay pending. A changed point count dirties all segments,
+    // so pending flags only need to be kept while the point count stays the same
+    for (FSplineMeshInitData* layer : Layers)
+    {
+        FSplineMeshInitData& meshInitData = *layer;
+        if (meshInitData.IsMerged())
+        {
+            meshInitData.bLayerPending = false;
+            meshInitData.PendingSegments.Init(false, numSplinePoints);
+            continue;
+        }
+        if (meshInitData.IsInstanced() || meshInitData.IsAdaptive() || meshInitData.IsDistributed())
+        {
+            meshInitData.bLayerPending |= meshInitData.bSettingsDirty || (numDirtySegments > 0);
+            meshInitData.PendingSegments.Init(false, numSplinePoints);
+            continue;
+        }
+
+        if (meshInitData.bSettingsDirty || meshInitData.PendingSegments.Num() != numSplinePoints)
+        {
+            meshInitData.PendingSegments.Init(meshInitData.bSettingsDirty, numSplinePoints);
+        }
+        for (TConstSetBitIterator<> dirtyIt(DirtySegments); dirtyIt; ++dirtyIt)
+        {
+            meshInitData.PendingSegments[dirtyIt.GetIndex()] = true;
+        }
+    }
+
+    // Prioritize by distance to the closest viewer in local space. Whole layers are updated first
+    TArray<FVector> viewLocations;
+    for (const FVector& viewLocation : GetWorld()->ViewLocationsRenderedLastFrame)
+    {
+        viewLocations.Add(ActorToWorld().InverseTransformPosition(viewLocation));
+    }
+
+    PendingSegmentOrder.Reset();
+    NextPendingSegment = 0;
+    for (const FSplineMeshInitData* layer : Layers)
+    {
+        const FSplineMeshInitData& meshInitData = *layer;
+        if (meshInitData.bLayerPending)
+        {
+            PendingSegmentOrder.Emplace(meshInitData.LayerID, INDEX_NONE, 0.f);
+        }
+
+        for (TConstSetBitIterator<> pendingIt(meshInitData.PendingSegments); pendingIt; ++pendingIt)
+        {
+            const FVector& location = SplineFrames[pendingIt.GetIndex()].Location;
+            float priority          = viewLocations.Num() > 0 ? MAX_flt : 0.f;
+            for (const FVector& viewLocation : viewLocations)
+            {
+                priority = FMath::Min(priority, FVector::DistSquared(location, viewLocation));
+            }
+            PendingSegmentOrder.Emplace(meshInitData.LayerID, pendingIt.GetIndex(), priority);
+        }
+    }
+
+    PendingSegmentOrder.Sort([](const FFlexPendingSegment& A, const FFlexPendingSegment& B)
+    {
+        return A.Priority < B.Priority;
+    });
+
+    if (IsConstructionPending())
+    {
+        FFlexSplineConstructionManager::Get().Enqueue(this);
+    }
+    else
+    {
+        OnConstructionCompleted.Broadcast(this);
+    }
+}
+
+void AFlexSplineActor::InitializeNewMeshData()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineInitializeNewMeshData);
+
+    const int32 meshInitMapNum = MeshDataInitMap.Num();
+
+    for (auto& meshInitDataPair : MeshDataInitMap)
+    {
+        FSplineMeshInitData& meshInitData = meshInitDataPair.Value;
+        if (!meshInitData.IsInitialized())
+        {
+            // Generate name for new entry
+            for (int32 index = 0; index < meshInitMapNum; index++)
+            {
+                const FString newLayerString = FString(TEXT("Layer " + FString::FromInt(index)));
+                const FName newLayerName     = FName(*newLayerString);
+                if ( (!MeshDataInitMap.Contains(newLayerName)) && (newLayerName != LastUsedKey) )
+                {
+                    meshInitDataPair.Key = newLayerName;
+                    LastUsedKey          = newLayerName;
+                    break;
+                }
+            }
+
+            // Init data from template, a preset brings its own
+            meshInitData = LayerPreset ? LayerPreset->LayerTemplate : MeshDataTemplate;
+            meshInitData.Initialize();
+        }
+    }
+}
+
+void AFlexSplineActor::GatherLayers()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineGatherLayers);
+
+    Layers.Reset(MeshDataInitMap.Num());
+    TSet<int32> usedLayerIDs;
+
+    for (auto& meshInitDataPair : MeshDataInitMap)
+    {
+        FSplineMeshInitData& meshInitData = meshInitDataPair.Value;
+
+        // Layers saved before identifiers existed, or copied from another layer, receive a new identifier
+        bool bIsAlreadyUsed = false;
+        usedLayerIDs.Add(meshInitData.LayerID, &bIsAlreadyUsed);
+        if (meshInitData.LayerID == INDEX_NONE || bIsAlreadyUsed)
+        {
+            meshInitData.LayerID = NextLayerID++;
+            usedLayerIDs.Add(meshInitData.LayerID);
+        }
+
+        meshInitData.LayerName = meshInitDataPair.Key;
+        meshInitData.LayerSeed = CombineRandomKey(MixRandomBits(RandomSeed), meshInitData.LayerID);
+        Layers.Add(&meshInitData);
+    }
+
+    // Preset layers that were removed from the preset or are overridden now release their components along with their instance
+    for (auto presetLayerIt = PresetLayers.CreateIterator(); presetLayerIt; ++presetLayerIt)
+    {
+        if (!LayerPreset || !LayerPreset->Layers.Contains(presetLayerIt.Key()) || MeshDataInitMap.Contains(presetLayerIt.Key()))
+        {
+            presetLayerIt.RemoveCurrent();
+        }
+    }
+    for (auto presetLayerIDIt = PresetLayerIDs.CreateIterator(); presetLayerIDIt; ++presetLayerIDIt)
+    {
+        if (!LayerPreset || !LayerPreset->Layers.Contains(presetLayerIDIt.Key()))
+        {
+            presetLayerIDIt.RemoveCurrent();
+        }
+    }
+    if (!LayerPreset)
+    {
+        return;
+    }
+
+    // Settings are copied on every rebuild, the layer hash then limits mesh updates to layers the preset changed
+    for (const auto& presetLayerPair : LayerPreset->Layers)
+    {
+        if (!MeshDataInitMap.Contains(presetLayerPair.Key))
+        {
+            PresetLayers.FindOrAdd(presetLayerPair.Key).CopySettings(presetLayerPair.Value);
+        }
+    }
+
+    // Only gathered once the map is complete, adding entries may move the others
+    for (auto& presetLayerPair : PresetLayers)
+    {
+        FSplineMeshInitData& presetLayer = presetLayerPair.Value;
+
+        const int32* presetLayerID = PresetLayerIDs.Find(presetLayerPair.Key);
+        if (!presetLayerID || usedLayerIDs.Contains(*presetLayerID))
+        {
+            presetLayerID = &PresetLayerIDs.Add(presetLayerPair.Key, NextLayerID++);
+        }
+        presetLayer.LayerID = *presetLayerID;
+        usedLayerIDs.Add(presetLayer.LayerID);
+
+        presetLayer.LayerName = presetLayerPair.Key;
+        presetLayer.LayerSeed = CombineRandomKey(MixRandomBits(RandomSeed), presetLayer.LayerID);
+        Layers.Add(&presetLayer);
+    }
+}
+
+void AFlexSplineActor::DiffSplinePoints(FFlexPointDiff& OutDiff) const
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineDiffSplinePoints);
+
+    const int32 numSplinePoints = SplineFrames.Num();
+    const int32 numPointData    = PointData.Num();
+    OutDiff.SourceIndices.Init(INDEX_NONE, numSplinePoints);
+
+    // Editing paths reported every insertion and removal, so each spline point still knows its point data
+    if (SplinePointIDs.Num() == numSplinePoints)
+    {
+        TMap<int32, int32> dataIndexByID;
+        dataIndexByID.Reserve(numPointData);
+        for (int32 dataIndex = 0; dataIndex < numPointData; dataIndex++)
+        {
+            if (PointData.PointIDs[dataIndex] != INDEX_NONE)
+            {
+                dataIndexByID.Add(PointData.PointIDs[dataIndex], dataIndex);
+            }
+        }
+
+        TBitArray<> keptData(false, numPointData);
+        for (int32 index = 0; index < numSplinePoints; index++)
+        {
+            const int32* dataIndex = (SplinePointIDs[index] != INDEX_NONE) ? dataIndexByID.Find(SplinePointIDs[index]) : nullptr;
+            if (!dataIndex || keptData[*dataIndex])
+            {
+                OutDiff.NumInserted++;
+                continue;
+            }
+
+            OutDiff.SourceIndices[index] = *dataIndex;
+            keptData[*dataIndex]         = true;
+            if (PointData.LastLocations[*dataIndex] != SplineFrames[index].Location)
+            {
+                OutDiff.NumMoved++;
+            }
+        }
+
+        for (int32 dataIndex = 0; dataIndex < numPointData; dataIndex++)
+        {
+            if (!keptData[dataIndex])
+            {
+                OutDiff.DeletedIndices.Add(dataIndex);
+            }
+        }
+        return;
+    }
+
+    // Chain point data sharing the same location in ascending order, so duplicates are matched in order too.
+    // Data without identifier has never been matched against the spline and has no reliable location
+    TMap<FVector, int32> firstDataAtLocation;
+    TArray<int32> nextDataAtLocation;
+    firstDataAtLocation.Reserve(numPointData);
+    nextDataAtLocation.SetNumUninitialized(numPointData);
+    for (int32 dataIndex = numPointData - 1; dataIndex >= 0; dataIndex--)
+    {
+        const FVector& lastLocation   = PointData.LastLocations[dataIndex];
+        const int32* nextDataIndex    = firstDataAtLocation.Find(lastLocation);
+        nextDataAtLocation[dataIndex] = nextDataIndex ? *nextDataIndex : INDEX_NONE;
+        if (PointData.PointIDs[dataIndex] != INDEX_NONE)
+        {
+            firstDataAtLocation.Add(lastLocation, dataIndex);
+        }
+    }
+
+    // Points that kept their location anchor the diff. Anchors keep their order, so every chain entry is visited once
+    int32 lastAnchorData = INDEX_NONE;
+    for (int32 index = 0; index < numSplinePoints; index++)
+    {
+        int32* dataIndex = firstDataAtLocation.Find(SplineFrames[index].Location);
+        while (dataIndex && *dataIndex != INDEX_NONE && *dataIndex <= lastAnchorData)
+        {
+            *dataIndex = nextDataAtLocation[*dataIndex];
+        }
+
+        if (dataIndex && *dataIndex != INDEX_NONE)
+        {
+            OutDiff.SourceIndices[index] = *dataIndex;
+            lastAnchorData               = *dataIndex;
+            *dataIndex                   = nextDataAtLocation[*dataIndex];
+        }
+    }
+
+    // Remaining points and data between two anchors are paired in order: paired points have moved,
+    // surplus data belongs to deleted points and surplus points were inserted
+    int32 gapStartIndex = 0;
+    int32 gapStartData  = 0;
+    for (int32 index = 0; index <= numSplinePoints; index++)
+    {
+        const int32 anchorData = (index < numSplinePoints) ? OutDiff.SourceIndices[index] : numPointData;
+        if (anchorData == INDEX_NONE)
+        {
+            continue;
+        }
+
+        for (int32 gapIndex = gapStartIndex; gapIndex < index; gapIndex++)
+        {
+            if (gapStartData < anchorData)
+            {
+                OutDiff.SourceIndices[gapIndex] = gapStartData++;
+                OutDiff.NumMoved++;
+            }
+            else
+            {
+                OutDiff.NumInserted++;
+            }
+        }
+
+        for (; gapStartData < anchorData; gapStartData++)
+        {
+            OutDiff.DeletedIndices.Add(gapStartData);
+        }
+
+        gapStartIndex = index + 1;
+        gapStartData  = anchorData + 1;
+    }
+}
+
+void AFlexSplineActor::ApplyPointDiff(const FFlexPointDiff& Diff)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineApplyPointDiff);
+
+    const int32 numSplinePoints = Diff.SourceIndices.Num();
+
+    // Nothing was inserted or deleted, all data stays at its index
+    if (!Diff.HasInsertionsOrDeletions())
+    {
+        return;
+    }
+
+    // Release all components of deleted points
+    for (const int32 dataIndex : Diff.DeletedIndices)
+    {
+        const int32 pointID = PointData.PointIDs[dataIndex];
+        for (FSplineMeshInitData* layer : Layers)
+        {
+            ReleaseMeshComponent(*layer, pointID);
+        }
+    }
+
+    // Make sure inserted points are never mistaken for clean ones
+    for (int32 index = 0; index < numSplinePoints; index++)
+    {
+        if (Diff.SourceIndices[index] == INDEX_NONE && PointHashCache.IsValidIndex(index))
+        {
+            PointHashCache[index] = 0;
+        }
+    }
+
+    // Compact point data in a single pass per channel, inserted points receive new data
+    PointData.Remap(Diff.SourceIndices);
+}
+
+void AFlexSplineActor::UpdatePointData()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdatePointData);
+
+    // Identify new points and remember where each point is, to match them against the next rebuild
+    const int32 numPointData = PointData.Num();
+    for (int32 index = 0; index < numPointData; index++)
+    {
+        int32& pointID = PointData.PointIDs[index];
+        if (pointID == INDEX_NONE)
+        {
+            pointID = NextPointID++;
+        }
+        PointData.LastLocations[index] = SplineFrames[index].Location;
+    }
+    SplinePointIDs = PointData.PointIDs;
+}
+
+void AFlexSplineActor::UpdateSplineFrames()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateSplineFrames);
+
+    const int32 numSplinePoints = SplineComponent->GetNumberOfSplinePoints();
+    SplineFrames.SetNumUninitialized(numSplinePoints);
+
+    for (int32 index = 0; index < numSplinePoints; index++)
+    {
+        FFlexSplineFrame& frame = SplineFrames[index];
+        frame.Location          = SplineComponent->GetLocationAtSplinePoint(index, LocalSpace);
+        frame.Tangent           = SplineComponent->GetTangentAtSplinePoint(index, LocalSpace);
+        frame.Direction         = frame.Tangent.GetSafeNormal();
+        frame.Rotation          = SplineComponent->GetRotationAtSplinePoint(index, LocalSpace);
+        frame.Scale             = SplineComponent->GetScaleAtSplinePoint(index);
+        frame.DirectionRotation = frame.Direction.Rotation();
+    }
+
+    // Needs the directions of both neighbours, so it can only be derived once all frames are evaluated
+    for (int32 index = 0; index < numSplinePoints; index++)
+    {
+        const int32 nextIndex          = (index + 1 < numSplinePoints) ? (index + 1) : index;
+        const int32 previousIndex      = (index > 0)                   ? (index - 1) : index;
+        SplineFrames[index].UpRotation = FMath::Lerp(SplineFrames[previousIndex].Direction, SplineFrames[nextIndex].Direction, 0.5f).Rotation();
+    }
+}
+
+void AFlexSplineActor::UpdateArcLengthTable()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateArcLengthTable);
+
+    ArcLengthTable.Reset();
+
+    const int32 numSplinePoints = SplineFrames.Num();
+    const bool bAnyByDistance   = Layers.ContainsByPredicate([this](const FSplineMeshInitData* Layer)
+    {
+        return Layer->IsDistributed() || GetUsesDistanceCurves(*Layer);
+    });
+    if (!bAnyByDistance || numSplinePoints < 2)
+    {
+        return;
+    }
+
+    // Sum up chords between dense samples of every segment, including the one closing the loop
+    const int32 numSamples = numSplinePoints * ArcLengthSamplesPerSegment + 1;
+    ArcLengthTable.Keys.SetNumUninitialized(numSamples);
+    ArcLengthTable.Distances.SetNumUninitialized(numSamples);
+    ArcLengthTable.Keys[0]      = 0.f;
+    ArcLengthTable.Distances[0] = 0.f;
+
+    FVector lastLocation = SplineFrames[0].Location;
+    for (int32 sampleIndex = 1; sampleIndex < numSamples; sampleIndex++)
+    {
+        const int32 index                 = (sampleIndex - 1) / ArcLengthSamplesPerSegment;
+        const float alpha                 = static_cast<float>(sampleIndex - index * ArcLengthSamplesPerSegment) / ArcLengthSamplesPerSegment;
+        const FFlexSplineFrame& frame     = SplineFrames[index];
+        const FFlexSplineFrame& nextFrame = SplineFrames[(index + 1) % numSplinePoints];
+        const FVector location            = FMath::CubicInterp(frame.Location, frame.Tangent, nextFrame.Location, nextFrame.Tangent, alpha);
+
+        ArcLengthTable.Keys[sampleIndex]      = index + alpha;
+        ArcLengthTable.Distances[sampleIndex] = ArcLengthTable.Distances[sampleIndex - 1] + FVector::Dist(lastLocation, location);
+        lastLocation                          = location;
+    }
+}
+
+void AFlexSplineActor::GatherDirtySegments(TBitArray<>& OutDirtySegments)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineGatherDirtySegments);
+
+    const int32 numSplinePoints = SplineComponent->GetNumberOfSplinePoints();
+
+    // Global settings or a changed point count (indices have shifted) affect every segment
+    uint32 globalHash = 0;
+    globalHash = HashValue(CollisionActive, globalHash);
+    globalHash = HashValue(Synchronize, globalHash);
+    globalHash = HashValue(Loop, globalHash);
+    globalHash = HashCurveInfo(CurveInfo, globalHash);
+
+    const bool bRebuildAll = (globalHash != GlobalSettingsHash) || (PointHashCache.Num() != numSplinePoints);
+    GlobalSettingsHash     = globalHash;
+    PointHashCache.SetNumZeroed(numSplinePoints);
+    OutDirtySegments.Init(bRebuildAll, numSplinePoints);
+
+    for (int32 index = 0; index < numSplinePoints; index++)
+    {
+        const uint32 pointHash = GeneratePointDataHash(PointData, index, GenerateSplineFrameHash(SplineFrames[index]));
+        if (pointHash != PointHashCache[index])
+        {
+            PointHashCache[index] = pointHash;
+
+            // A point shapes the segment ending in it and its own segment. The next segment may be synchronized
+            // with it and up directions local to spline points use the directions of both neighbours
+            const int32 previousIndex       = (index > 0) ? (index - 1) : (numSplinePoints - 1);
+            const int32 nextIndex           = (index + 1) % numSplinePoints;
+            OutDirtySegments[previousIndex] = true;
+            OutDirtySegments[index]         = true;
+            OutDirtySegments[nextIndex]     = true;
+        }
+    }
+
+    // Layers with changed settings need all of their meshes updated. Curves measured by distance shift along
+    // the whole spline whenever any segment changes its length
+    const bool bAnyDirtySegment = (OutDirtySegments.Find(true) != INDEX_NONE);
+    for (FSplineMeshInitData* layer : Layers)
+    {
+        FSplineMeshInitData& meshInitData = *layer;
+        const uint32 layerHash            = GenerateLayerSettingsHash(meshInitData);
+        meshInitData.bSettingsDirty       = (layerHash != meshInitData.LastBuildHash) || (bAnyDirtySegment && GetUsesDistanceCurves(meshInitData));
+        meshInitData.LastBuildHash        = layerHash;
+    }
+}
+
+void AFlexSplineActor::PrepareMeshComponents()
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplinePrepareMeshComponents);
+
+    // Only layers with changed settings can switch between merged meshes, instances, adaptive and per point components
+    for (FSplineMeshInitData* layer : Layers)
+    {
+        FSplineMeshInitData& meshInitData = *layer;
+        if (!meshInitData.bSettingsDirty)
+        {
+            continue;
+        }
+
+        const bool bMerged = meshInitData.IsMerged();
+        if (bMerged || !meshInitData.IsAdaptive())
+        {
+            for (WeakStaticMeshComp& adaptiveMesh : meshInitData.AdaptiveMeshComponents)
+            {
+                ReleaseComponent(adaptiveMesh.Get());
+            }
+            meshInitData.AdaptiveMeshComponents.Reset();
+        }
+        if (!meshInitData.IsAdaptive())
+        {
+            meshInitData.AdaptiveSegments.Reset();
+        }
+
+        // Distributed layers with instancing render through the instanced component instead
+        if (bMerged || !meshInitData.IsDistributed() || meshInitData.IsInstanced())
+        {
+            for (WeakStaticMeshComp& distributedMesh : meshInitData.DistributedMeshComponents)
+            {
+                ReleaseComponent(distributedMesh.Get());
+            }
+            meshInitData.DistributedMeshComponents.Reset();
+        }
+        if (!meshInitData.IsDistributed())
+        {
+            meshInitData.DistributedSegments.Reset();
+        }
+
+        // Merged meshes, instances, adaptive and distributed segments replace all per point components of this layer
+        if (bMerged || meshInitData.IsInstanced() || meshInitData.IsAdaptive() || meshInitData.IsDistributed())
+        {
+            for (auto& meshPair : meshInitData.MeshComponents)
+            {
+                ReleaseComponent(meshPair.Value.Get());
+            }
+            meshInitData.MeshComponents.Reset();
+        }
+
+        if (!bMerged && meshInitData.IsInstanced())
+        {
+            if (!meshInitData.InstancedMeshComponent.IsValid())
+            {
+                CreateInstancedMeshComponent(meshInitData);
+            }
+        }
+        else if (meshInitData.InstancedMeshComponent.IsValid())
+        {
+            meshInitData.InstancedMeshComponent->DestroyComponent();
+            meshInitData.InstancedMeshComponent.Reset();
+            INC_DWORD_STAT(STAT_FlexSplineComponentsDestroyed);
+        }
+
+        // Releases all merged mesh components if there are no merged meshes
+        UpdateMergedMeshes(meshInitData);
+    }
+}
+
+void AFlexSplineActor::ResolveSegments(const TBitArray<>& DirtySegments)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineResolveSegments);
+
+    const int32 numSplinePoints = SplineComponent->GetNumberOfSplinePoints();
+
+    // Random values only depend on layer settings and point identifiers. A changed identifier dirties its segment,
+    // so only batches of dirty segments need to be regenerated, unless the whole layer is dirty
+    const int32 numRandomBatches = FMath::DivideAndRoundUp(numSplinePoints, RandomBatchSize);
+    TBitArray<> dirtyRandomBatches(false, numRandomBatches);
+    for (TConstSetBitIterator<> dirtyIt(DirtySegments); dirtyIt; ++dirtyIt)
+    {
+        dirtyRandomBatches[dirtyIt.GetIndex() / RandomBatchSize] = true;
+    }
+
+    // Work is distributed over layers x points, random values over layers x batches
+    TArray<TPair<FSplineMeshInitData*, int32>> randomBatches;
+    for (FSplineMeshInitData* layer : Layers)
+    {
+        FSplineMeshInitData& meshInitData = *layer;
+        meshInitData.ResolvedSegments.SetNum(numSplinePoints);
+
+        const bool bRandomizeAll = meshInitData.bSettingsDirty || (meshInitData.RandomOffsets.Num() != numSplinePoints);
+        meshInitData.RandomOffsets.SetNum(numSplinePoints);
+        for (int32 batchIndex = 0; batchIndex < numRandomBatches; batchIndex++)
+        {
+            if (bRandomizeAll || dirtyRandomBatches[batchIndex])
+            {
+                randomBatches.Emplace(&meshInitData, batchIndex);
+            }
+        }
+    }
+
+    // Generate random values once per layer and point, every segment then reads them from the layer
+    const bool bSingleThread = (CVarParallelConstruction.GetValueOnGameThread() == 0);
+    ParallelFor(randomBatches.Num(), [&](int32 WorkIndex)
+    {
+        const int32 startIndex = randomBatches[WorkIndex].Value * RandomBatchSize;
+        const int32 endIndex   = FMath::Min(startIndex + RandomBatchSize, numSplinePoints);
+        GenerateRandomOffsets(*randomBatches[WorkIndex].Key, PointData.PointIDs, startIndex, endIndex);
+    }, bSingleThread);
+
+    // Spawn rolls are known now, bring the visibility of all layers up to date
+    ParallelFor(Layers.Num(), [&](int32 LayerIndex)
+    {
+        UpdateVisibilityMask(*Layers[LayerIndex], DirtySegments);
+    }, bSingleThread);
+
+    // Hidden segments are only flagged, visible ones are gathered for resolving. Layers placed by distance
+    // own no mesh per spline point, all of their per point segments stay hidden
+    TArray<TPair<FSplineMeshInitData*, int32>> visibleSegments;
+    for (FSplineMeshInitData* layer : Layers)
+    {
+        FSplineMeshInitData& meshInitData = *layer;
+        const bool bPerPoint              = !meshInitData.IsDistributed();
+        if (meshInitData.bSettingsDirty)
+        {
+            for (FFlexResolvedSegment& segment : meshInitData.ResolvedSegments)
+            {
+                segment.bVisible = false;
+            }
+            if (bPerPoint)
+            {
+                for (TConstSetBitIterator<> visibleIt(meshInitData.VisibilityMask); visibleIt; ++visibleIt)
+                {
+                    visibleSegments.Emplace(&meshInitData, visibleIt.GetIndex());
+                }
+            }
+        }
+        else
+        {
+            for (TConstSetBitIterator<> dirtyIt(DirtySegments); dirtyIt; ++dirtyIt)
+            {
+                const int32 index = dirtyIt.GetIndex();
+                meshInitData.ResolvedSegments[index].bVisible = false;
+                if (bPerPoint && meshInitData.VisibilityMask[index])
+                {
+                    visibleSegments.Emplace(&meshInitData, index);
+                }
+            }
+        }
+    }
+
+    // Visible segments are grouped by layer. Static meshes of a layer are composed in batches of consecutive
+    // entries, spline meshes are resolved one segment per work item
+    TArray<int32> visibleIndices;
+    TArray<TPair<int32, int32>> workItems;
+    visibleIndices.Reserve(visibleSegments.Num());
+    for (int32 first = 0; first < visibleSegments.Num();)
+    {
+        FSplineMeshInitData* layer = visibleSegments[first].Key;
+        const bool bBatched        = (layer->MeshInfo.MeshType == EFlexSplineMeshType::StaticMesh);
+        const int32 maxBatchSize   = bBatched ? StaticMeshBatchSize : 1;
+
+        int32 last = first;
+        while (last < visibleSegments.Num() && visibleSegments[last].Key == layer && (last - first) < maxBatchSize)
+        {
+            visibleIndices.Add(visibleSegments[last].Value);
+            last++;
+        }
+        workItems.Emplace(first, last - first);
+        first = last;
+    }
+
+    // Curves are sampled at every spline point and the end of the last segment, so spline meshes read both of their ends
+    TArray<float> pointKeys;
+    pointKeys.SetNumUninitialized(numSplinePoints + 1);
+    for (int32 index = 0; index <= numSplinePoints; index++)
+    {
+        pointKeys[index] = static_cast<float>(index);
+    }
+
+    // Layers placed by distance sample their curves at each of their meshes instead
+    ParallelFor(Layers.Num(), [&](int32 LayerIndex)
+    {
+        FSplineMeshInitData& meshInitData = *Layers[LayerIndex];
+        if (meshInitData.IsDistributed())
+        {
+            meshInitData.CurveSamples.Reset();
+        }
+        else
+        {
+            SampleCurves(meshInitData, pointKeys, meshInitData.CurveSamples);
+        }
+    }, bSingleThread);
 
-    // Spline Component
-    SplineComponent = CreateDefaultSubobject<USplineComponent>(TEXT("Spline"));
-    SplineComponent->SetMobility(EComponentMobility::Static);
-    RootComponent = SplineComponent;
-}
+    // Side-effect free: only reads spline frames, point and layer data and writes each segment's own buffer entry
+    ParallelFor(workItems.Num(), [&](int32 WorkIndex)
+    {
+        const int32 first                 = workItems[WorkIndex].Key;
+        const int32 num                   = workItems[WorkIndex].Value;
+        FSplineMeshInitData& meshInitData = *visibleSegments[first].Key;
 
-void AFlexSplineActor::OnConstruction(const FTransform& Transform)
-{
-    Super::OnConstruction(Transform);
+        switch (meshInitData.MeshInfo.MeshType)
+        {
+        case EFlexSplineMeshType::SplineMesh:
+        {
+            const int32 index             = visibleIndices[first];
+            FFlexResolvedSegment& segment = meshInitData.ResolvedSegments[index];
+            segment.bVisible              = true;
+            ResolveSplineMesh(meshInitData, index, segment);
+            break;
+        }
+        case EFlexSplineMeshType::StaticMesh:
+            ResolveStaticMeshes(meshInitData, &visibleIndices[first], num);
+            break;
+        default:
+            break;
+        }
+    }, bSingleThread);
 
-    // FlexSpline construction for editor builds here
-    ConstructSplineMesh();
-}
+    // Adaptive layers are resampled from their complete resolved segments, once per layer
+    const int32 numDirtySegments = DirtySegments.CountSetBits();
+    TArray<FSplineMeshInitData*> adaptiveLayers;
+    for (FSplineMeshInitData* layer : Layers)
+    {
+        if (layer->IsAdaptive() && (layer->bSettingsDirty || numDirtySegments > 0))
+        {
+            adaptiveLayers.Add(layer);
+        }
+    }
 
-void AFlexSplineActor::PreInitializeComponents()
-{
-    Super::PreInitializeComponents();
+    ParallelFor(adaptiveLayers.Num(), [&](int32 LayerIndex)
+    {
+        ResolveAdaptiveSegments(*adaptiveLayers[LayerIndex]);
+    }, bSingleThread);
 
-    // FlexSpline construction for cooked builds here because it has no OnConstrcution
-#if !WITH_EDITOR
-    ConstructSplineMesh();
-#endif
+    // Any changed segment shifts the distance of everything behind it, so distributed layers are resolved as a whole.
+    // Each of them runs in parallel across its meshes
+    for (FSplineMeshInitData* layer : Layers)
+    {
+        if (layer->IsDistributed() && (layer->bSettingsDirty || numDirtySegments > 0))
+        {
+            ResolveDistributedSegments(*layer);
+        }
+    }
 }
 
-int32 AFlexSplineActor::GetMeshCountForType(EFlexSplineMeshType MeshType) const
+void AFlexSplineActor::ResolveAdaptiveSegments(FSplineMeshInitData& MeshInitData) const
 {
-    int32 count = 0;
-    for (const auto& meshInitDataPair : MeshDataInitMap)
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineResolveAdaptiveSegments);
+
+    const TArray<FFlexResolvedSegment>& segments = MeshInitData.ResolvedSegments;
+    const int32 numSegments                      = segments.Num();
+    MeshInitData.AdaptiveSegments.Reset();
+
+    // Runs never wrap around, so a closed loop always starts and ends at the first spline point
+    int32 runStart = INDEX_NONE;
+    for (int32 index = 0; index < numSegments; index++)
     {
-        const auto& meshInitData = meshInitDataPair.Value;
-        if ( (meshInitData.MeshInfo.MeshType == MeshType) && (TEST_BIT(meshInitData.GeneralInfo, EFlexGeneralFlags::Active)) )
+        if (!MeshInitData.VisibilityMask[index])
         {
-            count++;
+            continue;
+        }
+        if (runStart == INDEX_NONE)
+        {
+            runStart = index;
+        }
+
+        // End the run before the next segment if it is hidden or would change the look of the meshes
+        const int32 nextIndex = index + 1;
+        const bool bRunEnds   = (nextIndex >= numSegments)
+                             || !MeshInitData.VisibilityMask[nextIndex]
+                             || !CanJoinSegments(segments[index], segments[nextIndex]);
+        if (bRunEnds)
+        {
+            const FFlexSegmentRun run(segments, runStart, index);
+            SubdivideRun(run, runStart, index + 1, MeshInitData.SegmentationInfo, 0, MeshInitData.AdaptiveSegments);
+            runStart = INDEX_NONE;
         }
     }
-    return count;
 }
 
-
-//////////////////////////////////////////////////////////////////////////
-// FLEX SPLINE FUNCTIONALITY
-void AFlexSplineActor::ConstructSplineMesh()
+void AFlexSplineActor::ResolveDistributedSegments(FSplineMeshInitData& MeshInitData) const
 {
-    // Get all indices that were deleted, if any
-    TArray<int32> deletedIndices;
-    GetDeletedIndices(deletedIndices);
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineResolveDistributedSegments);
 
-    InitializeNewMeshData();
+    MeshInitData.DistributedSegments.Reset();
 
-    // Check if number of spline points and point data align, add or remove data accordingly
-    AddPointDataEntries();
-    RemovePointDataEntries(deletedIndices);
-
-    // Check if number of spline points and meshes align, add or remove meshes accordingly
-    InitDataAddMeshes();
-    InitDataRemoveMeshes(deletedIndices);
+    const int32 numSplinePoints = SplineFrames.Num();
+    if (numSplinePoints < 2 || ArcLengthTable.Distances.Num() == 0)
+    {
+        return;
+    }
 
-    // Update the spline itself with the gathered data
-    UpdatePointData();
-    UpdateMeshComponents();
-    UpdateDebugInformation();
-}
+    // Only looping layers cover the segment back to the first spline point. A closed loop places no mesh
+    // at its very end, since it would coincide with the one at its start
+    const bool bLoop                    = GetCanLoop(MeshInitData);
+    const float endKey                  = static_cast<float>(bLoop ? numSplinePoints : (numSplinePoints - 1));
+    const int32 lastSegmentIndex        = bLoop ? (numSplinePoints - 1) : (numSplinePoints - 2);
+    const FFlexPlacementInfo& placement = MeshInitData.PlacementInfo;
+    const FFlexRenderInfo& renderInfo   = MeshInitData.RenderInfo;
+    const float spacing                 = FMath::Max(1.f, placement.Spacing);
+    const float length                  = ArcLengthTable.GetDistanceAtKey(endKey);
+    const float placedLength            = length - placement.StartDistance;
+    if (placedLength < 0.f)
+    {
+        return;
+    }
 
-void AFlexSplineActor::InitializeNewMeshData()
-{
-    const int32 meshInitMapNum = MeshDataInitMap.Num();
+    const int32 numMeshes = bLoop ? FMath::CeilToInt(placedLength / spacing) : (FMath::FloorToInt(placedLength / spacing) + 1);
+    MeshInitData.DistributedSegments.SetNum(numMeshes);
+    TArray<float> meshKeys;
+    meshKeys.SetNumUninitialized(numMeshes);
 
-    for (auto& meshInitDataPair : MeshDataInitMap)
+    // Meshes are identified by their index along the spline, which keys their random values
+    const bool bSingleThread = (CVarParallelConstruction.GetValueOnGameThread() == 0);
+    ParallelFor(numMeshes, [&](int32 MeshIndex)
     {
-        FSplineMeshInitData& meshInitData = meshInitDataPair.Value;
-        if (!meshInitData.IsInitialized())
+        FFlexResolvedSegment& segment = MeshInitData.DistributedSegments[MeshIndex];
+        const uint32 meshKey          = CombineRandomKey(MeshInitData.LayerSeed, MeshIndex);
+        const float jitter            = placement.SpacingJitter * spacing * RandomSigned(meshKey, EFlexRandomChannel::SpacingJitter);
+        const float distance          = FMath::Clamp(placement.StartDistance + MeshIndex * spacing + jitter, 0.f, length);
+        const float key               = FMath::Min(ArcLengthTable.GetKeyAtDistance(distance), endKey);
+        const int32 index             = FMath::Min(FMath::FloorToInt(key), lastSegmentIndex);
+        meshKeys[MeshIndex]           = key;
+
+        // Render rules select whole segments between spline points, spawn chance applies to each mesh
+        const bool bSpawns = renderInfo.bRandomizeSpawnChance
+                           ? (renderInfo.SpawnChance > RandomUnit(meshKey, EFlexRandomChannel::SpawnChance))
+                           : CanRenderFromAccumulatedSpawnChance(renderInfo.SpawnChance, MeshIndex);
+        segment.bVisible   = MeshInitData.RenderRuleMask[index] && bSpawns;
+    }, bSingleThread);
+
+    // All meshes know their input keys now, so curves are sampled at each of them in one sweep
+    FFlexCurveSamples meshCurves;
+    SampleCurves(MeshInitData, meshKeys, meshCurves);
+
+    ParallelFor(numMeshes, [&](int32 MeshIndex)
+    {
+        FFlexResolvedSegment& segment = MeshInitData.DistributedSegments[MeshIndex];
+        if (!segment.bVisible)
         {
-            // Generate name for new entry
-            for (int32 index = 0; index < meshInitMapNum; index++)
-            {
-                const FString newLayerString = FString(TEXT("Layer " + FString::FromInt(index)));
-                const FName newLayerName     = FName(*newLayerString);
-                if ( (!MeshDataInitMap.Contains(newLayerName)) && (newLayerName != LastUsedKey) )
-                {
-                    meshInitDataPair.Key = newLayerName;
-                    LastUsedKey          = newLayerName;
-                    break;
-                }
-            }
-
-            // Init data from template
-            meshInitData = MeshDataTemplate;
-            meshInitData.Initialize();
+            return;
         }
-    }
+
+        // Overrides of the spline points around the mesh are blended by its position in between
+        const float key       = meshKeys[MeshIndex];
+        const int32 index     = FMath::Min(FMath::FloorToInt(key), lastSegmentIndex);
+        const float alpha     = key - index;
+        const int32 nextIndex = (index + 1) % numSplinePoints;
+        FSplinePointData point;
+        point.SMLocationOffset = FMath::Lerp(PointData.GetSMLocationOffset(index), PointData.GetSMLocationOffset(nextIndex), alpha) + meshCurves.GetSMLocationOffset(MeshIndex);
+        point.SMScale          = FMath::Lerp(PointData.GetSMScale(index), PointData.GetSMScale(nextIndex), alpha) + meshCurves.GetSMScale(MeshIndex);
+        point.SMRotation       = FMath::Lerp(PointData.GetSMRotation(index), PointData.GetSMRotation(nextIndex), alpha) + meshCurves.GetSMRotation(MeshIndex);
+
+        FFlexRandomOffsets random;
+        GenerateRandomOffset(MeshInitData, CombineRandomKey(MeshInitData.LayerSeed, MeshIndex), random);
+        const FFlexSplineFrame frame = GetSplineFrameAtKey(key);
+        segment.Location             = CalculateLocation(MeshInitData, point, frame, random);
+        segment.Rotation             = CalculateRotation(MeshInitData, point, frame, random);
+        segment.Scale                = CalculateScale(MeshInitData, point, frame, random);
+    }, bSingleThread);
+
+    // Distributed segments only keep what is rendered
+    MeshInitData.DistributedSegments.RemoveAll([](const FFlexResolvedSegment& Segment)
+    {
+        return !Segment.bVisible;
+    });
 }
 
-void AFlexSplineActor::AddPointDataEntries()
+void AFlexSplineActor::SampleCurves(const FSplineMeshInitData& MeshInitData, const TArray<float>& Keys, FFlexCurveSamples& OutSamples) const
 {
-    const int32 pointDataArraySize = PointDataArray.Num();
-    const int32 numberOfSplinePoints = SplineComponent->GetNumberOfSplinePoints();
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineSampleCurves);
 
-    for (int32 i = pointDataArraySize; i < numberOfSplinePoints; i++)
+    const FFlexCurveInfo& layerCurves = MeshInitData.CurveInfo;
+    if (!layerCurves.HasCurves() && !CurveInfo.HasCurves())
     {
-        FSplinePointData newPointData;
-
-        // Create text renderer to show point index in editor
-        UTextRenderComponent* newTextRender = NewObject<UTextRenderComponent>(RootComponent);
-        newTextRender->RegisterComponent();
-        newTextRender->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
-        newTextRender->SetWorldSize(PointNumberSize);
-        newTextRender->SetHiddenInGame(true);
-        newTextRender->SetTextRenderColor(TextRenderColor);
-        newPointData.IndexTextRenderer = newTextRender;
+        OutSamples.Reset();
+        return;
+    }
 
-        // Save entry
-        PointDataArray.Add(newPointData);
+    // Distances are normalized over the part of the spline the layer covers, the closing segment of a loop included
+    TArray<float> distances;
+    distances.SetNumZeroed(Keys.Num());
+    if (GetUsesDistanceCurves(MeshInitData) && ArcLengthTable.Distances.Num() > 0)
+    {
+        const int32 numSplinePoints = SplineFrames.Num();
+        const float endKey          = static_cast<float>(GetCanLoop(MeshInitData) ? numSplinePoints : (numSplinePoints - 1));
+        const float length          = FMath::Max(ArcLengthTable.GetDistanceAtKey(endKey), KINDA_SMALL_NUMBER);
+        for (int32 index = 0; index < Keys.Num(); index++)
+        {
+            distances[index] = ArcLengthTable.GetDistanceAtKey(Keys[index]) / length;
+        }
     }
+
+    // Samples are offsets added to point data. Scale curves replace the default scale of 1, so it is subtracted
+    SampleCurveChannel(&FFlexCurveInfo::Roll, layerCurves, CurveInfo, Keys, distances, OutSamples.Rolls,
+                       [](float Value) { return Value; });
+    SampleCurveChannel(&FFlexCurveInfo::Scale, layerCurves, CurveInfo, Keys, distances, OutSamples.Scales,
+                       [](const FVector& Value) { return FVector2D(Value.X - 1.f, Value.Y - 1.f); });
+    SampleCurveChannel(&FFlexCurveInfo::Offset, layerCurves, CurveInfo, Keys, distances, OutSamples.Offsets,
+                       [](const FVector& Value) { return FVector2D(Value.X, Value.Y); });
+    SampleCurveChannel(&FFlexCurveInfo::UpDirection, layerCurves, CurveInfo, Keys, distances, OutSamples.UpDirections,
+                       [](const FVector& Value) { return Value; });
+    SampleCurveChannel(&FFlexCurveInfo::SMLocationOffset, layerCurves, CurveInfo, Keys, distances, OutSamples.SMLocationOffsets,
+                       [](const FVector& Value) { return Value; });
+    SampleCurveChannel(&FFlexCurveInfo::SMScale, layerCurves, CurveInfo, Keys, distances, OutSamples.SMScales,
+                       [](const FVector& Value) { return Value; });
+    SampleCurveChannel(&FFlexCurveInfo::SMRotation, layerCurves, CurveInfo, Keys, distances, OutSamples.SMRotations,
+                       [](const FVector& Value) { return FRotator(Value.Y, Value.Z, Value.X); });
 }
 
-void AFlexSplineActor::RemovePointDataEntries(const TArray<int32>& DeletedIndices)
+void AFlexSplineActor::UpdateMeshComponents(const TBitArray<>& DirtySegments)
 {
-    // Use gathered indices to clean up and delete redundant data
-    for (const int32 index : DeletedIndices)
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateMeshComponents);
+
+    const int32 numSplinePoints  = SplineComponent->GetNumberOfSplinePoints();
+    const int32 numDirtySegments = DirtySegments.CountSetBits();
+    int32 numUpdatedSegments     = 0;
+
+    // Push resolved data of all dirty segments to the components
+    for (FSplineMeshInitData* layer : Layers)
     {
-        const FSplinePointData& pointData = PointDataArray[index];
+        FSplineMeshInitData& meshInitData = *layer;
 
-        // Remove this point's text-render
-        UTextRenderComponent* indexText = pointData.IndexTextRenderer;
-        if (indexText)
+        // Merged meshes are set up along with the layer and never change with the spline
+        if (meshInitData.IsMerged())
         {
-            indexText->DestroyComponent();
+            continue;
         }
 
-        // Remove arrows
-        for (auto& meshInitDataPair : MeshDataInitMap)
+        // Instanced layers are rebuilt as a whole, since hidden points are omitted from the instance buffer.
+        // Clean segments still hold their resolved data from earlier rebuilds
+        if (meshInitData.IsInstanced())
         {
-            FSplineMeshInitData& meshInitData = meshInitDataPair.Value;
-            WeakArrowComp arrow               = meshInitData.ArrowSplineUpIndicatorArray[index];
-            if (arrow.IsValid())
+            if (meshInitData.bSettingsDirty || numDirtySegments > 0)
             {
-                meshInitData.ArrowSplineUpIndicatorArray.Remove(arrow);
-                arrow->DestroyComponent();
+                UpdateInstancedMesh(meshInitData);
+                numUpdatedSegments += meshInitData.bSettingsDirty ? numSplinePoints : numDirtySegments;
             }
+            continue;
         }
 
-        PointDataArray.RemoveAt(index);
-    }
-}
-
-void AFlexSplineActor::InitDataAddMeshes()
-{
-    // Each mesh-init data stores all spline mesh components of its type, their location scattered across all spline points
-    // Here we add spline meshes until it has as many meshes as there are spline points
-    for (auto& meshInitDataPair : MeshDataInitMap)
-    {
-        FSplineMeshInitData& meshInitData = meshInitDataPair.Value;
-        UClass* meshType                  = GetMeshType(meshInitData.MeshInfo.MeshType);
-        const int32 numberOfSplinePoints  = SplineComponent->GetNumberOfSplinePoints();
-        const int32 numberOfSplineMeshes  = meshInitData.MeshComponentsArray.Num();
+        // Adaptive and distributed segments have no fixed relation to spline points, so they are updated as a whole too
+        if (meshInitData.IsAdaptive())
+        {
+            if (meshInitData.bSettingsDirty || numDirtySegments > 0)
+            {
+                numUpdatedSegments += UpdateAdaptiveMeshes(meshInitData);
+            }
+            continue;
+        }
+        if (meshInitData.IsDistributed())
+        {
+            if (meshInitData.bSettingsDirty || numDirtySegments > 0)
+            {
+                numUpdatedSegments += UpdateDistributedMeshes(meshInitData);
+            }
+            continue;
+        }
 
-        if (numberOfSplineMeshes < numberOfSplinePoints)
+        // Dirty layers revisit all points, since any of them may have been shown or hidden
+        if (meshInitData.bSettingsDirty)
+        {
+            for (int32 index = 0; index < numSplinePoints; index++)
+            {
+                numUpdatedSegments += UpdateMeshComponent(meshInitData, index) ? 1 : 0;
+            }
+        }
+        else
         {
-            for (int32 i = numberOfSplineMeshes; i < numberOfSplinePoints; i++)
+            for (TConstSetBitIterator<> dirtyIt(DirtySegments); dirtyIt; ++dirtyIt)
             {
-                CreateMeshComponent(meshType, meshInitData);
-                CreateArrrowComponent(meshInitData);
+                numUpdatedSegments += UpdateMeshComponent(meshInitData, dirtyIt.GetIndex()) ? 1 : 0;
             }
         }
     }
+
+    INC_DWORD_STAT_BY(STAT_FlexSplineSegmentsUpdated, numUpdatedSegments);
+    LastConstructionTimings.NumUpdatedSegments += numUpdatedSegments;
 }
 
-void AFlexSplineActor::InitDataRemoveMeshes(const TArray<int32>& DeletedIndices)
+bool AFlexSplineActor::UpdateMeshComponent(FSplineMeshInitData& MeshInitData, int32 Index)
 {
-    for (const int32 index : DeletedIndices)
+    const int32 pointID                 = PointData.PointIDs[Index];
+    const FFlexResolvedSegment& segment = MeshInitData.ResolvedSegments[Index];
+
+    // Hidden points own no component
+    if (!segment.bVisible)
     {
-        // Remove all spline Meshes at this spline index (which was removed)
-        for (auto& meshInitDataPair : MeshDataInitMap)
-        {
-            FSplineMeshInitData& meshInitData = meshInitDataPair.Value;
-            const int32 numberOfSplinePoints  = SplineComponent->GetNumberOfSplinePoints();
-            const int32 numberOfSplineMeshes  = meshInitData.MeshComponentsArray.Num();
+        ReleaseMeshComponent(MeshInitData, pointID);
+        return false;
+    }
 
-            if (numberOfSplineMeshes > numberOfSplinePoints)
-            {
-                DestroyMeshComponent(meshInitData, index);
-            }
-        }
+    // Create a mesh if there is none, or replace it if the mesh type has changed
+    UClass* configuredMeshType = GetMeshType(MeshInitData.MeshInfo.MeshType);
+    WeakStaticMeshComp& mesh   = MeshInitData.MeshComponents.FindOrAdd(pointID);
+    if (mesh.IsValid() && mesh->GetClass() != configuredMeshType)
+    {
+        ReleaseComponent(mesh.Get());
+        mesh.Reset();
+    }
+    if (!mesh.IsValid())
+    {
+        mesh = CreateMeshComponent(configuredMeshType);
+    }
+
+    // Update type agnostic mesh settings
+    UStaticMeshComponent* meshComp = mesh.Get();
+    meshComp->SetVisibility(true);
+    UpdateMeshSettings(MeshInitData, meshComp);
+
+    // Update type dependent mesh settings
+    if (configuredMeshType == SplineMeshClass)
+    {
+        UpdateSplineMesh(MeshInitData, CastChecked<USplineMeshComponent>(meshComp), segment);
+    }
+    else if (configuredMeshType == StaticMeshClass)
+    {
+        UpdateStaticMesh(MeshInitData, meshComp, segment);
     }
+
+    return true;
 }
 
-void AFlexSplineActor::UpdatePointData()
+void AFlexSplineActor::UpdateMeshSettings(const FSplineMeshInitData& MeshInitData, UStaticMeshComponent* Mesh)
 {
-    const int32 pointDataArraySize = PointDataArray.Num();
-    for (int32 index = 0; index < pointDataArraySize; index++)
+    Mesh->SetCollisionProfileName(MeshInitData.PhysicsInfo.CollisionProfileName);
+    Mesh->SetCollisionEnabled(GetCollisionEnabled(MeshInitData));
+    Mesh->bGenerateOverlapEvents = MeshInitData.PhysicsInfo.bGenerateOverlapEvent;
+    Mesh->SetMobility(EComponentMobility::Movable); // <- Required for SetStaticMesh to work correctly
+    Mesh->SetStaticMesh(MeshInitData.MeshInfo.Mesh);
+    Mesh->SetMobility(EComponentMobility::Static);
+    Mesh->SetMaterial(0, MeshInitData.MeshInfo.MeshMaterial);
+
+    // Render cost, the render state is only recreated once at the end
+    const FFlexRenderCostInfo& renderCost = MeshInitData.RenderCostInfo;
+    Mesh->MinDrawDistance       = renderCost.MinDrawDistance;
+    Mesh->LDMaxDrawDistance     = renderCost.MaxDrawDistance;
+    Mesh->CachedMaxDrawDistance = renderCost.MaxDrawDistance;
+    Mesh->CastShadow            = renderCost.bCastShadow;
+    Mesh->bCastDynamicShadow    = renderCost.bCastDynamicShadow;
+    Mesh->ForcedLodModel        = renderCost.ForcedLodModel;
+    Mesh->bOverrideMinLOD       = (renderCost.MinLOD > 0);
+    Mesh->MinLOD                = renderCost.MinLOD;
+    Mesh->DetailMode            = renderCost.DetailMode;
+
+    // Instances are culled per instance instead
+    UHierarchicalInstancedStaticMeshComponent* instancedMesh = Cast<UHierarchicalInstancedStaticMeshComponent>(Mesh);
+    if (instancedMesh)
     {
-        FSplinePointData& pointData = PointDataArray[index];
+        instancedMesh->InstanceStartCullDistance = FMath::RoundToInt(renderCost.MaxDrawDistance);
+        instancedMesh->InstanceEndCullDistance   = FMath::RoundToInt(renderCost.MaxDrawDistance);
+    }
+    Mesh->MarkRenderStateDirty();
+}
+
+void AFlexSplineActor::UpdateSplineMesh(const FSplineMeshInitData& MeshInitData, USplineMeshComponent* SplineMesh, const FFlexResolvedSegment& Segment)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateSplineMesh);
 
-        // Update ID
-        pointData.ID = GeneratePointHashValue(SplineComponent, index);
+    if (SplineMesh)
+    {
+        // Set spline params, the render state is only updated once at the end
+        SplineMesh->SetRelativeLocation(Segment.Location);
+        SplineMesh->SetStartAndEnd(Segment.StartLocation, Segment.StartTangent, Segment.EndLocation, Segment.EndTangent, false);
+        SplineMesh->SetStartOffset(Segment.StartOffset, false);
+        SplineMesh->SetEndOffset(Segment.EndOffset, false);
+        SplineMesh->SetSplineUpDir(Segment.UpDirection, false);
+        SplineMesh->SetForwardAxis(ToSplineAxis(MeshInitData.MeshInfo.MeshForwardAxis), false);
+        SplineMesh->SetRelativeRotation(Segment.Rotation);
+        SplineMesh->SetRelativeScale3D(FVector(Segment.Scale.X, SplineMesh->RelativeScale3D.Y, SplineMesh->RelativeScale3D.Z));
+
+        // Apply spline point data
+        SplineMesh->SetStartRoll(Segment.StartRoll, false);
+        SplineMesh->SetEndRoll(Segment.EndRoll, false);
+        SplineMesh->SetStartScale(Segment.StartScale, false);
+        SplineMesh->SetEndScale(Segment.EndScale, false);
+        SplineMesh->UpdateMesh();
     }
 }
 
-void AFlexSplineActor::UpdateDebugInformation()
+void AFlexSplineActor::UpdateStaticMesh(const FSplineMeshInitData& MeshInitData, UStaticMeshComponent* StaticMesh, const FFlexResolvedSegment& Segment)
 {
-    const int32 pointDataArraySize = PointDataArray.Num();
-    for (int32 index = 0; index < pointDataArraySize; index++)
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateStaticMesh);
+
+    if (StaticMesh)
     {
-        FSplinePointData& pointData = PointDataArray[index];
+        // Apply mesh-init configurations
+        StaticMesh->SetRelativeLocation(Segment.Location);
+        StaticMesh->SetRelativeRotation(Segment.Rotation);
+        StaticMesh->SetRelativeScale3D(Segment.Scale);
+    }
+}
 
-        // Update text renderer
-        UTextRenderComponent* textRenderer = pointData.IndexTextRenderer;
-        if (textRenderer)
-        {
-            const FRotator splineRotation = SplineComponent->GetRotationAtSplinePoint(index, LocalSpace);
-            textRenderer->SetWorldLocation(GetTextPosition(index));
-            textRenderer->SetText(FText::AsNumber(index));
-            textRenderer->SetTextRenderColor(TextRenderColor);
-            textRenderer->SetRelativeRotation(FRotator(0.f, -splineRotation.Yaw, 0.f));
-            textRenderer->SetWorldSize(PointNumberSize);
-            textRenderer->SetVisibility(bShowPointNumbers);
-        }
+void AFlexSplineActor::UpdateInstancedMesh(FSplineMeshInitData& MeshInitData)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateInstancedMesh);
 
-        // Update up-vector-arrow
-        int32 meshInitIndex = 0;
-        for (auto& meshInitDataPair : MeshDataInitMap)
-        {
-            FSplineMeshInitData& meshInitData      = meshInitDataPair.Value;
-            UArrowComponent* arrow                 = meshInitData.ArrowSplineUpIndicatorArray[index].Get();
-            const USplineMeshComponent* splineMesh = Cast<USplineMeshComponent>(meshInitData.MeshComponentsArray[index].Get());
+    UHierarchicalInstancedStaticMeshComponent* instancedMesh = MeshInitData.InstancedMeshComponent.Get();
+    if (instancedMesh)
+    {
+        UpdateMeshSettings(MeshInitData, instancedMesh);
 
-            if (meshInitData.UpVectorInfo.bShowUpDirection
-                && splineMesh
-                && arrow
-                && MeshDataInitMap.Num() > 0
-                && index != pointDataArraySize - 1)
+        // Hidden points are simply left out of the instance buffer, distributed segments are all visible
+        instancedMesh->ClearInstances();
+        if (MeshInitData.IsDistributed())
+        {
+            for (const FFlexResolvedSegment& segment : MeshInitData.DistributedSegments)
             {
-                arrow->SetRelativeRotation(splineMesh->GetSplineUpDir().Rotation());
-                arrow->SetWorldLocation(textRenderer->GetComponentLocation() + textRenderer->GetUpVector() * UpDirectionArrowOffset);
-                arrow->SetArrowColor(GetColorForArrow(meshInitIndex));
-                arrow->ArrowSize = UpDirectionArrowSize;
-                arrow->SetVisibility(true);
+                instancedMesh->AddInstance(FTransform(segment.Rotation, segment.Location, segment.Scale));
             }
-            else if (arrow)
+        }
+        else
+        {
+            for (TConstSetBitIterator<> visibleIt(MeshInitData.VisibilityMask); visibleIt; ++visibleIt)
             {
-                arrow->SetVisibility(false);
+                const FFlexResolvedSegment& segment = MeshInitData.ResolvedSegments[visibleIt.GetIndex()];
+                instancedMesh->AddInstance(FTransform(segment.Rotation, segment.Location, segment.Scale));
             }
-            meshInitIndex++;
         }
     }
 }
 
-void AFlexSplineActor::UpdateMeshComponents()
+int32 AFlexSplineActor::UpdateAdaptiveMeshes(FSplineMeshInitData& MeshInitData)
 {
-    const int32 numSplinePoints = SplineComponent->GetNumberOfSplinePoints();
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateAdaptiveMeshes);
 
-    // Update all meshes for the current mesh initializer
-    for (auto& meshInitDataPair : MeshDataInitMap)
+    // Adaptive segments have no identity, so surplus meshes are released and all others are updated
+    const int32 numSegments = MeshInitData.AdaptiveSegments.Num();
+    for (int32 index = numSegments; index < MeshInitData.AdaptiveMeshComponents.Num(); index++)
     {
-        FSplineMeshInitData& meshInitData = meshInitDataPair.Value;
-        UClass* configuredMeshType        = GetMeshType(meshInitData.MeshInfo.MeshType);
+        ReleaseComponent(MeshInitData.AdaptiveMeshComponents[index].Get());
+    }
+    MeshInitData.AdaptiveMeshComponents.SetNum(numSegments);
 
-        for (int32 index = 0; index < numSplinePoints; index++)
+    for (int32 index = 0; index < numSegments; index++)
+    {
+        WeakStaticMeshComp& mesh = MeshInitData.AdaptiveMeshComponents[index];
+        if (!mesh.IsValid())
         {
-            UStaticMeshComponent* meshComp = meshInitData.MeshComponentsArray[index].Get();
-            UClass* meshType               = meshComp->GetClass();
+            mesh = CreateMeshComponent(SplineMeshClass);
+        }
 
-            // Replace mesh if type has changed
-            if (configuredMeshType != meshType)
-            {
-                DestroyMeshComponent(meshInitData, index);
-                CreateMeshComponent(configuredMeshType, meshInitData, index);
-                meshComp = meshInitData.MeshComponentsArray[index].Get();
-                meshType = meshComp->GetClass();
-            }
+        mesh->SetVisibility(true);
+        UpdateMeshSettings(MeshInitData, mesh.Get());
+        UpdateSplineMesh(MeshInitData, CastChecked<USplineMeshComponent>(mesh.Get()), MeshInitData.AdaptiveSegments[index]);
+    }
 
-            // Update mesh settings
-            const int32 finalIndex = numSplinePoints - 1;
+    return numSegments;
+}
 
-            if (!TEST_BIT(meshInitData.GeneralInfo, EFlexGeneralFlags::Active) // Inactive
-                || index == finalIndex && !GetCanLoop(meshInitData)            // No loop, so cut out last mesh 
-                || !CanRenderFromSpawnChance(meshInitData, index)              // Spawn chance too low
-                || !CanRenderFromMode(meshInitData, index, finalIndex))        // Render-Mode check
-            {
-                meshComp->SetVisibility(false);
-                meshComp->SetCollisionEnabled(ECollisionEnabled::NoCollision);
-            }
-            else
-            {
-                // Update type agnostic mesh settings
-                meshComp->SetCollisionProfileName(meshInitData.PhysicsInfo.CollisionProfileName);
-                meshComp->SetVisibility(true);
-                meshComp->SetCollisionEnabled(GetCollisionEnabled(meshInitData));
-                meshComp->bGenerateOverlapEvents = meshInitData.PhysicsInfo.bGenerateOverlapEvent;
-                meshComp->SetMobility(EComponentMobility::Movable); // <- Required for SetStaticMesh to work correctly
-                meshComp->SetStaticMesh(meshInitData.MeshInfo.Mesh);
-                meshComp->SetMobility(EComponentMobility::Static);
-                meshComp->SetMaterial(0, meshInitData.MeshInfo.MeshMaterial);
-
-                // Update type dependent mesh settings
-                if (meshType == SplineMeshClass)
-                {
-                    USplineMeshComponent* splineMeshComp = Cast<USplineMeshComponent>(meshComp);
-                    UpdateSplineMesh(meshInitData, splineMeshComp, index);
-                }
-                else if (meshType == StaticMeshClass)
-                {
-                    UpdateStaticMesh(meshInitData, meshComp, index);
-                }
-            }
+int32 AFlexSplineActor::UpdateDistributedMeshes(FSplineMeshInitData& MeshInitData)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateDistributedMeshes);
+
+    // Like adaptive segments, distributed ones have no identity beyond their index
+    const int32 numSegments = MeshInitData.DistributedSegments.Num();
+    for (int32 index = numSegments; index < MeshInitData.DistributedMeshComponents.Num(); index++)
+    {
+        ReleaseComponent(MeshInitData.DistributedMeshComponents[index].Get());
+    }
+    MeshInitData.DistributedMeshComponents.SetNum(numSegments);
+
+    for (int32 index = 0; index < numSegments; index++)
+    {
+        WeakStaticMeshComp& mesh = MeshInitData.DistributedMeshComponents[index];
+        if (!mesh.IsValid())
+        {
+            mesh = CreateMeshComponent(StaticMeshClass);
         }
+
+        mesh->SetVisibility(true);
+        UpdateMeshSettings(MeshInitData, mesh.Get());
+        UpdateStaticMesh(MeshInitData, mesh.Get(), MeshInitData.DistributedSegments[index]);
     }
+
+    return numSegments;
 }
 
-void AFlexSplineActor::UpdateSplineMesh(const FSplineMeshInitData& MeshInitData, USplineMeshComponent* SplineMesh, int32 CurrentIndex)
+void AFlexSplineActor::UpdateMergedMeshes(FSplineMeshInitData& MeshInitData)
 {
-    if (SplineMesh)
-    {
-        const FName layerName             = GetLayerName(MeshInitData);
-        const FSplinePointData& pointData = PointDataArray[CurrentIndex];
-        const bool bSync                  = GetCanSynchronize(pointData) && (CurrentIndex > 0);
-        auto&& previousPointData          = bSync ? PointDataArray[CurrentIndex - 1] : FSplinePointData();
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineUpdateMergedMeshes);
 
-        const FVector randScale         = MeshInitData.ScaleInfo.bUseUniformScaleRandomOffset
-                                        ? FVector(RandomizeFloat(MeshInitData.ScaleInfo.UniformScaleRandomOffset, CurrentIndex, layerName))
-                                        : RandomizeVector(MeshInitData.ScaleInfo.ScaleRandomOffset, CurrentIndex, layerName);
-        const FVector2D randScale2D     = FVector2D(randScale.Y, randScale.Z);
-        const FVector meshInitScale     = MeshInitData.ScaleInfo.bUseUniformScale
-                                        ? FVector(1.f, MeshInitData.ScaleInfo.UniformScale, MeshInitData.ScaleInfo.UniformScale)
-                                        : MeshInitData.ScaleInfo.Scale;
-        const FVector2D meshInitScale2D = FVector2D(meshInitScale.Y, meshInitScale.Z) + randScale2D;
-        const FRotator randRotator      = RandomizeRotator(MeshInitData.RotationInfo.RotationRandomOffset, CurrentIndex, layerName);
+    const TArray<UStaticMesh*>& mergedMeshes = MeshInitData.MergeInfo.MergedMeshes;
+    for (int32 index = mergedMeshes.Num(); index < MeshInitData.MergedMeshComponents.Num(); index++)
+    {
+        ReleaseComponent(MeshInitData.MergedMeshComponents[index].Get());
+    }
+    MeshInitData.MergedMeshComponents.SetNum(mergedMeshes.Num());
 
-        // Set spline params
-        SetSplineMeshLocation(MeshInitData, SplineMesh, CurrentIndex);
-        SplineMesh->SetSplineUpDir(CalculateUpDirection(MeshInitData, pointData, CurrentIndex), LocalSpace);
-        SplineMesh->SetForwardAxis(ToSplineAxis(MeshInitData.MeshInfo.MeshForwardAxis));
-        SplineMesh->SetRelativeRotation(MeshInitData.RotationInfo.Rotation + randRotator);
-        SplineMesh->SetRelativeScale3D(FVector(meshInitScale.X + randScale.X, SplineMesh->RelativeScale3D.Y, SplineMesh->RelativeScale3D.Z));
+    // Merged meshes are baked in actor space, with layer materials already applied
+    for (int32 index = 0; index < mergedMeshes.Num(); index++)
+    {
+        WeakStaticMeshComp& mesh = MeshInitData.MergedMeshComponents[index];
+        if (!mesh.IsValid())
+        {
+            mesh = CreateMeshComponent(StaticMeshClass);
+        }
 
-        // Apply spline point data (or sync with previous point if demanded)
-        SplineMesh->SetStartRoll(bSync ? previousPointData.EndRoll : pointData.StartRoll);
-        SplineMesh->SetEndRoll(pointData.EndRoll);
-        SplineMesh->SetStartScale((bSync ? previousPointData.EndScale : (pointData.StartScale)) * meshInitScale2D);
-        SplineMesh->SetEndScale(pointData.EndScale * meshInitScale2D);
+        UStaticMeshComponent* meshComp = mesh.Get();
+        meshComp->SetVisibility(true);
+        UpdateMeshSettings(MeshInitData, meshComp);
+        meshComp->SetMobility(EComponentMobility::Movable); // <- Required for SetStaticMesh to work correctly
+        meshComp->SetStaticMesh(mergedMeshes[index]);
+        meshComp->SetMobility(EComponentMobility::Static);
+        meshComp->SetRelativeTransform(FTransform::Identity);
     }
 }
 
-void AFlexSplineActor::UpdateStaticMesh(const FSplineMeshInitData& MeshInitData, UStaticMeshComponent* StaticMesh, int32 CurrentIndex)
+void AFlexSplineActor::ResolveSplineMesh(const FSplineMeshInitData& MeshInitData, int32 CurrentIndex, FFlexResolvedSegment& OutSegment) const
 {
-    if (StaticMesh)
+    const bool bSync                  = GetCanSynchronize(CurrentIndex) && (CurrentIndex > 0);
+    const FFlexRandomOffsets& random  = MeshInitData.RandomOffsets[CurrentIndex];
+
+    const FVector randScale         = random.Scale;
+    const FVector2D randScale2D     = FVector2D(randScale.Y, randScale.Z);
+    const FVector meshInitScale     = MeshInitData.ScaleInfo.bUseUniformScale
+                                    ? FVector(1.f, MeshInitData.ScaleInfo.UniformScale, MeshInitData.ScaleInfo.UniformScale)
+                                    : MeshInitData.ScaleInfo.Scale;
+    const FVector2D meshInitScale2D = FVector2D(meshInitScale.Y, meshInitScale.Z) + randScale2D;
+    const FRotator randRotator      = random.Rotation;
+
+    // Resolve spline params
+    ResolveSplineMeshLocation(MeshInitData, CurrentIndex, OutSegment);
+    OutSegment.UpDirection = CalculateUpDirection(MeshInitData, CurrentIndex);
+    OutSegment.Rotation    = MeshInitData.RotationInfo.Rotation + randRotator;
+    OutSegment.Scale       = FVector(meshInitScale.X + randScale.X, 1.f, 1.f);
+
+    // Apply spline point data (or sync with previous point if demanded), on top of curves sampled at both ends
+    const FFlexCurveSamples& curves = MeshInitData.CurveSamples;
+    OutSegment.StartRoll  = (bSync ? PointData.GetEndRoll(CurrentIndex - 1) : PointData.GetStartRoll(CurrentIndex)) + curves.GetRoll(CurrentIndex);
+    OutSegment.EndRoll    = PointData.GetEndRoll(CurrentIndex) + curves.GetRoll(CurrentIndex + 1);
+    OutSegment.StartScale = ((bSync ? PointData.GetEndScale(CurrentIndex - 1) : PointData.GetStartScale(CurrentIndex)) + curves.GetScale(CurrentIndex)) * meshInitScale2D;
+    OutSegment.EndScale   = (PointData.GetEndScale(CurrentIndex) + curves.GetScale(CurrentIndex + 1)) * meshInitScale2D;
+}
+
+void AFlexSplineActor::ResolveStaticMeshes(FSplineMeshInitData& MeshInitData, const int32* Indices, int32 NumIndices) const
+{
+    // Gather the inputs of all meshes into parallel arrays, so the kernels stream through them
+    TArray<FVector> frameLocations, frameScales, pointLocations, pointScales, randomLocations, randomScales, locations, scales;
+    TArray<FRotator> frameDirectionRotations, frameRotations, pointRotations, randomRotations, rotations;
+    for (TArray<FVector>* stream : { &frameLocations, &frameScales, &pointLocations, &pointScales, &randomLocations, &randomScales, &locations, &scales })
+    {
+        stream->SetNumUninitialized(NumIndices);
+    }
+    for (TArray<FRotator>* stream : { &frameDirectionRotations, &frameRotations, &pointRotations, &randomRotations, &rotations })
     {
-        const FSplinePointData& pointData = PointDataArray[CurrentIndex];
+        stream->SetNumUninitialized(NumIndices);
+    }
 
-        // Apply mesh-init configurations
-        StaticMesh->SetRelativeLocation(CalculateLocation(MeshInitData, pointData, CurrentIndex));
-        StaticMesh->SetRelativeRotation(CalculateRotation(MeshInitData, pointData, CurrentIndex));
-        StaticMesh->SetRelativeScale3D(CalculateScale(MeshInitData, pointData, CurrentIndex));
+    const FFlexCurveSamples& curves = MeshInitData.CurveSamples;
+    for (int32 i = 0; i < NumIndices; i++)
+    {
+        const int32 index                 = Indices[i];
+        const FFlexSplineFrame& frame     = SplineFrames[index];
+        const FFlexRandomOffsets& random  = MeshInitData.RandomOffsets[index];
+
+        frameLocations[i]          = frame.Location;
+        frameDirectionRotations[i] = frame.DirectionRotation;
+        frameRotations[i]          = frame.Rotation;
+        frameScales[i]             = frame.Scale;
+        pointLocations[i]          = PointData.GetSMLocationOffset(index) + curves.GetSMLocationOffset(index);
+        pointRotations[i]          = PointData.GetSMRotation(index) + curves.GetSMRotation(index);
+        pointScales[i]             = PointData.GetSMScale(index) + curves.GetSMScale(index);
+        randomLocations[i]         = random.Location;
+        randomRotations[i]         = random.Rotation;
+        randomScales[i]            = random.Scale;
     }
-}
 
-FName AFlexSplineActor::GetLayerName(const FSplineMeshInitData& MeshInitData) const
-{
-    const FName* result = MeshDataInitMap.FindKey(MeshInitData);
-    return (result) ? (*result) : (TEXT(""));
+    const FFlexTransformStreams streams = { frameLocations.GetData(), frameDirectionRotations.GetData(), frameRotations.GetData(), frameScales.GetData(),
+                                            pointLocations.GetData(), pointRotations.GetData(), pointScales.GetData(),
+                                            randomLocations.GetData(), randomRotations.GetData(), randomScales.GetData(), NumIndices };
+    const FFlexTransformOutputs outputs = { locations.GetData(), rotations.GetData(), scales.GetData() };
+    const FlexSplineMath::FFlexMathPlacement placement = MakePlacement(MeshInitData);
+    FlexSplineBatchKernels::ComposeStaticMeshTransforms(placement, streams, outputs);
+
+    for (int32 i = 0; i < NumIndices; i++)
+    {
+        FFlexResolvedSegment& segment = MeshInitData.ResolvedSegments[Indices[i]];
+        segment.bVisible              = true;
+        segment.Location              = locations[i];
+        segment.Rotation              = rotations[i];
+        segment.Scale                 = scales[i];
+    }
 }
 
 
 //////////////////////////////////////////////////////////////////////////
 // HELPERS
-void AFlexSplineActor::GetDeletedIndices(TArray<int32>& OutIndexArray) const
+void AFlexSplineActor::UpdateMemoryStats(bool bDestroying)
 {
-    OutIndexArray.Empty();
-    const int32 pointDataArraySize   = PointDataArray.Num();
-    const int32 numberOfSplinePoints = SplineComponent->GetNumberOfSplinePoints();
-
-    if (pointDataArraySize > numberOfSplinePoints)
+#if STATS
+    SIZE_T pointDataMemory = 0;
+    SIZE_T layerDataMemory = 0;
+    if (!bDestroying)
     {
-        // Move along a spline-point-data-pair and store all indices that do not match(CHECK FRONT)
-        int32 dataCounter        = 0;
-        int32 splinePointCounter = 0;
-        for (; splinePointCounter < numberOfSplinePoints; splinePointCounter++, dataCounter++)
+        pointDataMemory = PointData.GetAllocatedSize()
+            + PointHashCache.GetAllocatedSize()
+            + SplineFrames.GetAllocatedSize()
+            + ArcLengthTable.Keys.GetAllocatedSize()
+            + ArcLengthTable.Distances.GetAllocatedSize();
+
+        layerDataMemory = MeshDataInitMap.GetAllocatedSize()
+            + PresetLayers.GetAllocatedSize()
+            + PresetLayerIDs.GetAllocatedSize()
+            + Layers.GetAllocatedSize()
+            + PendingSegmentOrder.GetAllocatedSize();
+        ForEachLayer([&](const FSplineMeshInitData& MeshInitData)
         {
-            uint32 dataID        = PointDataArray[dataCounter].ID;
-            const uint32 pointID = GeneratePointHashValue(SplineComponent, splinePointCounter);
-
-            while (dataID != pointID)
-            {
-                OutIndexArray.AddUnique(dataCounter);
-                dataCounter++;
-                dataID = PointDataArray[dataCounter].ID;
-            }
+            layerDataMemory += MeshInitData.MeshComponents.GetAllocatedSize()
+                + MeshInitData.AdaptiveMeshComponents.GetAllocatedSize()
+                + MeshInitData.DistributedMeshComponents.GetAllocatedSize()
+                + MeshInitData.MergedMeshComponents.GetAllocatedSize()
+                + MeshInitData.ResolvedSegments.GetAllocatedSize()
+                + MeshInitData.AdaptiveSegments.GetAllocatedSize()
+                + MeshInitData.DistributedSegments.GetAllocatedSize()
+                + MeshInitData.RenderRuleMask.GetAllocatedSize()
+                + MeshInitData.VisibilityMask.GetAllocatedSize()
+                + MeshInitData.RandomOffsets.GetAllocatedSize()
+                + MeshInitData.CurveSamples.GetAllocatedSize()
+                + MeshInitData.PendingSegments.GetAllocatedSize();
+        });
+
+        layerDataMemory += BakedLayers.GetAllocatedSize();
+        for (const auto& bakedLayerPair : BakedLayers)
+        {
+            layerDataMemory += bakedLayerPair.Value.Segments.GetAllocatedSize() + bakedLayerPair.Value.PointIDs.GetAllocatedSize();
         }
+    }
+
+    // Stats are shared by all Flex Splines, so only report the change since the last call
+    DEC_MEMORY_STAT_BY(STAT_FlexSplinePointDataMemory, ReportedPointDataMemory);
+    DEC_MEMORY_STAT_BY(STAT_FlexSplineLayerDataMemory, ReportedLayerDataMemory);
+    INC_MEMORY_STAT_BY(STAT_FlexSplinePointDataMemory, pointDataMemory);
+    INC_MEMORY_STAT_BY(STAT_FlexSplineLayerDataMemory, layerDataMemory);
+    ReportedPointDataMemory = pointDataMemory;
+    ReportedLayerDataMemory = layerDataMemory;
+#endif
+}
 
-        // Store all indices from deleted spline points at the end of the spline(CHECK BACK)
-        const int32 lastSplineIndex = numberOfSplinePoints + OutIndexArray.Num() - 1;
-        const int32 lastDataIndex   = PointDataArray.Num() - 1;
-        for (dataCounter = lastDataIndex; dataCounter > lastSplineIndex; dataCounter--)
+FSplineMeshInitData* AFlexSplineActor::FindLayer(int32 LayerID)
+{
+    for (auto& meshInitDataPair : MeshDataInitMap)
+    {
+        if (meshInitDataPair.Value.LayerID == LayerID)
+        {
+            return &meshInitDataPair.Value;
+        }
+    }
+    for (auto& presetLayerPair : PresetLayers)
+    {
+        if (presetLayerPair.Value.LayerID == LayerID)
         {
-            OutIndexArray.AddUnique(dataCounter);
+            return &presetLayerPair.Value;
         }
-        // Put highest values on top, so highest indices are deleted first to avoid out-of-range-exception
-        OutIndexArray.Sort();
-        Algo::Reverse(OutIndexArray);
     }
+    return nullptr;
 }
 
 FVector AFlexSplineActor::GetTextPosition(int32 Index) const
 {
     // Return top of the highest bounding box from all meshes than can be found at this point
-    const int32 pointArrayMax         = PointDataArray.Num() - 1;
+    const int32 pointArrayMax         = PointData.Num() - 1;
     const FVector splinePointLocation = SplineComponent->GetLocationAtSplinePoint(Index, WorldSpace);
     float highestPoint                = splinePointLocation.Z;
 
-    for (const auto& meshInitDataPair : MeshDataInitMap)
+    ForEachLayer([&](const FSplineMeshInitData& MeshInitData)
     {
-        const FSplineMeshInitData& meshInitData = meshInitDataPair.Value;
-        const WeakStaticMeshComp mesh           = meshInitData.MeshComponentsArray[ (pointArrayMax == Index && Index > 0 && !GetCanLoop(meshInitData))
-                                                ? Index - 1
-                                                : Index ];
+        const int32 meshIndex          = (pointArrayMax == Index && Index > 0 && !GetCanLoop(MeshInitData))
+                                       ? Index - 1
+                                       : Index;
+        const WeakStaticMeshComp* mesh = MeshInitData.MeshComponents.Find(PointData.PointIDs[meshIndex]);
 
-        if (mesh.IsValid() && mesh->IsVisible())
+        if (mesh && mesh->IsValid() && (*mesh)->IsVisible())
         {
-            const float max = mesh->Bounds.GetBox().Max.Z;
+            const float max = (*mesh)->Bounds.GetBox().Max.Z;
             highestPoint    = FMath::Max(max, highestPoint);
         }
-    }
+    });
 
     return FVector(splinePointLocation.X, splinePointLocation.Y, highestPoint);
 }
 
-bool AFlexSplineActor::CanRenderFromMode(const FSplineMeshInitData& MeshInitData, int32 CurrentIndex, int32 FinalIndex) const
+void AFlexSplineActor::UpdateVisibilityMask(FSplineMeshInitData& MeshInitData, const TBitArray<>& DirtySegments) const
 {
-    bool result = false;
-    // When not looping, the final index should be one point earlier
-    FinalIndex = !GetCanLoop(MeshInitData) ? FinalIndex - 1 : FinalIndex;
-    FinalIndex = FMath::Max<int32>(0, FinalIndex);
+    const int32 numSplinePoints = DirtySegments.Num();
+    const uint32 ruleHash       = GenerateRenderRuleHash(MeshInitData, GetCanLoop(MeshInitData), numSplinePoints);
+    const bool bRulesChanged    = (ruleHash != MeshInitData.RenderRuleHash) || (MeshInitData.RenderRuleMask.Num() != numSplinePoints);
 
-    if (TEST_BIT(MeshInitData.RenderInfo.RenderMode, EFlexSplineRenderMode::Middle))
-    {
-        result = (CurrentIndex != 0) && (CurrentIndex != FinalIndex);
-    }
-    if (!result && TEST_BIT(MeshInitData.RenderInfo.RenderMode, EFlexSplineRenderMode::Head))
+    // Layers placed by distance roll their spawn chance per mesh
+    const bool bPerPointSpawnChance = MeshInitData.RenderInfo.bRandomizeSpawnChance && !MeshInitData.IsDistributed();
+
+    if (bRulesChanged)
     {
-        result = (CurrentIndex == 0);
+        CompileRenderRules(MeshInitData, GetCanLoop(MeshInitData), numSplinePoints, MeshInitData.RenderRuleMask);
+        MeshInitData.RenderRuleHash = ruleHash;
     }
-    if (!result && TEST_BIT(MeshInitData.RenderInfo.RenderMode, EFlexSplineRenderMode::Tail))
+
+    // Spawn rolls change with settings or with the point identifiers of dirty segments
+    if (bRulesChanged || MeshInitData.bSettingsDirty || (MeshInitData.VisibilityMask.Num() != numSplinePoints))
     {
-        result = (CurrentIndex == FinalIndex);
+        MeshInitData.VisibilityMask = MeshInitData.RenderRuleMask;
+        if (bPerPointSpawnChance)
+        {
+            for (TConstSetBitIterator<> ruleIt(MeshInitData.RenderRuleMask); ruleIt; ++ruleIt)
+            {
+                MeshInitData.VisibilityMask[ruleIt.GetIndex()] = CanRenderFromRandomSpawnChance(MeshInitData, ruleIt.GetIndex());
+            }
+        }
     }
-    if (!result && TEST_BIT(MeshInitData.RenderInfo.RenderMode, EFlexSplineRenderMode::Custom))
+    else
     {
-        result = MeshInitData.RenderInfo.RenderModeCustomIndices.Contains(CurrentIndex);
+        for (TConstSetBitIterator<> dirtyIt(DirtySegments); dirtyIt; ++dirtyIt)
+        {
+            const int32 index                  = dirtyIt.GetIndex();
+            MeshInitData.VisibilityMask[index] = MeshInitData.RenderRuleMask[index] && (!bPerPointSpawnChance || CanRenderFromRandomSpawnChance(MeshInitData, index));
+        }
     }
-
-    return result;
 }
 
 ECollisionEnabled::Type AFlexSplineActor::GetCollisionEnabled(const FSplineMeshInitData& MeshInitData) const
@@ -668,7 +2935,13 @@ bool AFlexSplineActor::GetCanLoop(const FSplineMeshInitData& MeshInitData) const
     return result;
 }
 
-bool AFlexSplineActor::GetCanSynchronize(const FSplinePointData& PointData) const
+bool AFlexSplineActor::GetUsesDistanceCurves(const FSplineMeshInitData& MeshInitData) const
+{
+    return (MeshInitData.CurveInfo.HasCurves() && MeshInitData.CurveInfo.Domain == EFlexCurveDomain::Distance)
+        || (CurveInfo.HasCurves() && CurveInfo.Domain == EFlexCurveDomain::Distance);
+}
+
+bool AFlexSplineActor::GetCanSynchronize(int32 Index) const
 {
     bool result = false;
 
@@ -676,143 +2949,162 @@ bool AFlexSplineActor::GetCanSynchronize(const FSplinePointData& PointData) cons
     {
     case EFlexGlobalConfigType::Everywhere: result = true; break;
     case EFlexGlobalConfigType::Nowhere:    result = false; break;
-    case EFlexGlobalConfigType::Custom:     result = PointData.bSynchroniseWithPrevious; break;
+    case EFlexGlobalConfigType::Custom:     result = PointData.GetSynchroniseWithPrevious(Index); break;
     default: break;
     }
 
     return result;
 }
 
-FVector AFlexSplineActor::CalculateLocation(const FSplineMeshInitData& MeshInitData, const FSplinePointData& PointData, const int32 Index) const
+FFlexSplineFrame AFlexSplineActor::GetSplineFrameAtKey(float Key) const
 {
-    const FVector splinePointLocation = SplineComponent->GetLocationAtSplinePoint(Index, LocalSpace);
-    FVector meshInitLocation          = MeshInitData.LocationInfo.Location;
-    FVector pointDataLocationOffset   = PointData.SMLocationOffset;
-    FVector randomizedVector          = RandomizeVector(MeshInitData.LocationInfo.LocationRandomOffset, Index, GetLayerName(MeshInitData));
+    const int32 numSplinePoints       = SplineFrames.Num();
+    const int32 index                 = FMath::Clamp(FMath::FloorToInt(Key), 0, numSplinePoints - 1);
+    const float alpha                 = Key - index;
+    const FFlexSplineFrame& frame     = SplineFrames[index];
+    const FFlexSplineFrame& nextFrame = SplineFrames[(index + 1) % numSplinePoints];
+
+    FFlexSplineFrame result;
+    result.Location  = FMath::CubicInterp(frame.Location, frame.Tangent, nextFrame.Location, nextFrame.Tangent, alpha);
+    result.Tangent   = FMath::CubicInterpDerivative(frame.Location, frame.Tangent, nextFrame.Location, nextFrame.Tangent, alpha);
+    result.Direction = result.Tangent.GetSafeNormal();
+    result.Scale     = FMath::Lerp(frame.Scale, nextFrame.Scale, alpha);
+
+    // Roll is blended between both spline points, while the rotation keeps following the curve
+    const FQuat blendedRotation = FQuat::Slerp(frame.Rotation.Quaternion(), nextFrame.Rotation.Quaternion(), alpha);
+    result.Rotation             = result.Direction.IsNearlyZero()
+                                ? blendedRotation.Rotator()
+                                : FRotationMatrix::MakeFromXZ(result.Direction, blendedRotation.GetUpVector()).Rotator();
+    result.DirectionRotation    = result.Direction.Rotation();
+    result.UpRotation           = result.DirectionRotation;
+    return result;
+}
 
-    if (MeshInitData.LocationInfo.CoordinateSystem == EFlexCoordinateSystem::SplinePoint)
-    {
-        const FRotator coordSystem  = SplineComponent->GetDirectionAtSplinePoint(Index, LocalSpace).Rotation();
-        // Rotate all values around new local coordinate system
-        meshInitLocation        = coordSystem.RotateVector(meshInitLocation);
-        pointDataLocationOffset = coordSystem.RotateVector(pointDataLocationOffset);
-        randomizedVector        = coordSystem.RotateVector(randomizedVector);
-    }
+FVector AFlexSplineActor::CalculateLocation(const FSplineMeshInitData& MeshInitData, const FSplinePointData& Point,
+                                            const FFlexSplineFrame& Frame, const FFlexRandomOffsets& Random) const
+{
+    return FromMath(FlexSplineMath::ComputeLocation(MakePlacement(MeshInitData), ToMath(Frame.Location), ToMath(Frame.DirectionRotation),
+                                                    ToMath(Point.SMLocationOffset), ToMath(Random.Location)));
+}
 
-    return splinePointLocation + meshInitLocation + pointDataLocationOffset + randomizedVector;
+FRotator AFlexSplineActor::CalculateRotation(const FSplineMeshInitData& MeshInitData, const FSplinePointData& Point,
+                                             const FFlexSplineFrame& Frame, const FFlexRandomOffsets& Random) const
+{
+    return FromMath(FlexSplineMath::ComputeRotation(MakePlacement(MeshInitData), ToMath(Frame.Rotation),
+                                                    ToMath(Point.SMRotation), ToMath(Random.Rotation)));
 }
 
-FRotator AFlexSplineActor::CalculateRotation(const FSplineMeshInitData& MeshInitData, const FSplinePointData& PointData, const int32 Index) const
+FVector AFlexSplineActor::CalculateScale(const FSplineMeshInitData& MeshInitData, const FSplinePointData& Point,
+                                         const FFlexSplineFrame& Frame, const FFlexRandomOffsets& Random) const
 {
-    const FRotator meshInitRotation    = MeshInitData.RotationInfo.Rotation;
-    const FRotator randomRotation      = RandomizeRotator(MeshInitData.RotationInfo.RotationRandomOffset, Index, GetLayerName(MeshInitData));
-    const FRotator pointDataRotation   = PointData.SMRotation;
-    const FRotator splinePointRotation = MeshInitData.RotationInfo.CoordinateSystem == EFlexCoordinateSystem::SplinePoint
-                                       ? SplineComponent->GetRotationAtSplinePoint(Index, LocalSpace)
-                                       : FRotator::ZeroRotator;
+    return FromMath(FlexSplineMath::ComputeScale(MakePlacement(MeshInitData), ToMath(Frame.Scale),
+                                                 ToMath(Point.SMScale), ToMath(Random.Scale)));
+}
 
-    return meshInitRotation + randomRotation + pointDataRotation + splinePointRotation;
+FVector AFlexSplineActor::CalculateUpDirection(const FSplineMeshInitData& MeshInitData, const int32 Index) const
+{
+    return FromMath(FlexSplineMath::ComputeUpDirection(MakePlacement(MeshInitData), ToMath(SplineFrames[Index].UpRotation),
+                                                       ToMath(PointData.GetUpDirection(Index) + MeshInitData.CurveSamples.GetUpDirection(Index))));
 }
 
-FVector AFlexSplineActor::CalculateScale(const FSplineMeshInitData& MeshInitData, const FSplinePointData& PointData, const int32 Index) const
+void AFlexSplineActor::ResolveSplineMeshLocation(const FSplineMeshInitData& MeshInitData, int32 Index, FFlexResolvedSegment& OutSegment) const
 {
-    const FName layerName          = GetLayerName(MeshInitData);
-    const FVector randomScale      = MeshInitData.ScaleInfo.bUseUniformScaleRandomOffset
-                                   ? FVector(RandomizeFloat(MeshInitData.ScaleInfo.UniformScaleRandomOffset, Index, layerName))
-                                   : RandomizeVector(MeshInitData.ScaleInfo.ScaleRandomOffset, Index, layerName);
-    const FVector pointDataScale   = PointData.SMScale;
-    const FVector splinePointScale = SplineComponent->GetScaleAtSplinePoint(Index);
-    const FVector meshInitScale    = MeshInitData.ScaleInfo.bUseUniformScale
-                                   ? FVector(MeshInitData.ScaleInfo.UniformScale)
-                                   : MeshInitData.ScaleInfo.Scale;
+    const int32 nextIndex             = (Index + 1) % SplineFrames.Num(); // Need to account for looping here
+    const bool bSync                  = GetCanSynchronize(Index) && (Index > 0);
+    const FFlexSplineFrame& frame     = SplineFrames[Index];
+    const FFlexSplineFrame& nextFrame = SplineFrames[nextIndex];
+
+    // Point local offsets move each end of the spline mesh, spline local offsets the whole component
+    const auto coordinateSystem = static_cast<FlexSplineMath::ECoordinateSystem::Type>(MeshInitData.LocationInfo.CoordinateSystem);
+    const FlexSplineMath::FFlexMathSegmentEnds ends = FlexSplineMath::ComputeSegmentEnds(
+        coordinateSystem, ToMath(MeshInitData.LocationInfo.Location),
+        ToMath(frame.Location),     ToMath(frame.DirectionRotation),     ToMath(MeshInitData.RandomOffsets[Index].Location),
+        ToMath(nextFrame.Location), ToMath(nextFrame.DirectionRotation), ToMath(MeshInitData.RandomOffsets[nextIndex].Location));
+
+    OutSegment.Location      = FromMath(ends.Location);
+    OutSegment.StartLocation = FromMath(ends.StartLocation);
+    OutSegment.StartTangent  = frame.Tangent;
+    OutSegment.EndLocation   = FromMath(ends.EndLocation);
+    OutSegment.EndTangent    = nextFrame.Tangent;
+    OutSegment.StartOffset   = (bSync ? PointData.GetEndOffset(Index - 1) : PointData.GetStartOffset(Index)) + MeshInitData.CurveSamples.GetOffset(Index);
+    OutSegment.EndOffset     = PointData.GetEndOffset(Index) + MeshInitData.CurveSamples.GetOffset(Index + 1);
+}
 
-    return (meshInitScale * splinePointScale) + pointDataScale + randomScale;
+UStaticMeshComponent* AFlexSplineActor::CreateMeshComponent(UClass* MeshType)
+{
+    return CastChecked<UStaticMeshComponent>(AcquireComponent(MeshType));
 }
 
-FVector AFlexSplineActor::CalculateUpDirection(const FSplineMeshInitData& MeshInitData, const FSplinePointData& PointData, const int32 Index) const
+UHierarchicalInstancedStaticMeshComponent* AFlexSplineActor::CreateInstancedMeshComponent(FSplineMeshInitData& MeshInitData)
 {
-    FVector meshInitUpDir = MeshInitData.UpVectorInfo.CustomMeshUpDirection;
-    FVector pointUpDir    = PointData.CustomPointUpDirection;
+    UHierarchicalInstancedStaticMeshComponent* newInstancedMesh = NewObject<UHierarchicalInstancedStaticMeshComponent>(this);
+    newInstancedMesh->RegisterComponent();
+    newInstancedMesh->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
+    MeshInitData.InstancedMeshComponent = newInstancedMesh;
+    LastConstructionTimings.NumCreatedComponents++;
+    INC_DWORD_STAT(STAT_FlexSplineComponentsCreated);
+
+    return newInstancedMesh;
+}
 
-    if (MeshInitData.UpVectorInfo.CoordinateSystem == EFlexCoordinateSystem::SplinePoint)
+void AFlexSplineActor::ReleaseMeshComponent(FSplineMeshInitData& MeshInitData, int32 PointID)
+{
+    WeakStaticMeshComp mesh;
+    if (MeshInitData.MeshComponents.RemoveAndCopyValue(PointID, mesh) && mesh.IsValid())
     {
-        // Convert vectors to be local to spline point
-        const int32 nextIndex            = (Index + 1 < SplineComponent->GetNumberOfSplinePoints()) ? (Index + 1) : Index;
-        const int32 previousIndex        = (Index > 0)                                              ? (Index - 1) : Index;
-        const FVector nextIndexDirection = SplineComponent->GetDirectionAtSplinePoint(nextIndex, LocalSpace);
-        const FVector prevIndexDirection = SplineComponent->GetDirectionAtSplinePoint(previousIndex, LocalSpace);
-        const FRotator coordSystem       = FMath::Lerp(prevIndexDirection, nextIndexDirection, 0.5f).Rotation();
-        meshInitUpDir                    = coordSystem.RotateVector(meshInitUpDir);
-        pointUpDir                       = coordSystem.RotateVector(pointUpDir);
+        ReleaseComponent(mesh.Get());
     }
-
-    return meshInitUpDir + pointUpDir;
 }
 
-void AFlexSplineActor::SetSplineMeshLocation(const FSplineMeshInitData& MeshInitData, USplineMeshComponent* OutSplineMesh, int32 Index)
+USceneComponent* AFlexSplineActor::AcquireComponent(UClass* ComponentClass)
 {
-    if (OutSplineMesh)
-    {
-        const FSplinePointData& pointData = PointDataArray[Index];
-        const int32 nextIndex             = (Index + 1) % SplineComponent->GetNumberOfSplinePoints(); // Need to account for looping here
-        const bool bSync                  = GetCanSynchronize(pointData) && (Index > 0);
-        auto&& previousPointData          = bSync ? PointDataArray[Index - 1] : FSplinePointData();
-        const FName layerName             = GetLayerName(MeshInitData);
-
-        const FVector startTangent             = SplineComponent->GetTangentAtSplinePoint(Index, LocalSpace);
-        const FVector endTangent               = SplineComponent->GetTangentAtSplinePoint(nextIndex, LocalSpace);
-        FVector startLocation                  = SplineComponent->GetLocationAtSplinePoint(Index, LocalSpace);
-        FVector endLocation                    = SplineComponent->GetLocationAtSplinePoint(nextIndex, LocalSpace);
-        const FVector randomVectorCurrentIndex = RandomizeVector(MeshInitData.LocationInfo.LocationRandomOffset, Index, layerName);
-        const FVector randomVectorNextIndex    = RandomizeVector(MeshInitData.LocationInfo.LocationRandomOffset, nextIndex, layerName);
+    USceneComponent* component = nullptr;
 
-        if (MeshInitData.LocationInfo.CoordinateSystem == EFlexCoordinateSystem::SplinePoint)
-        {
-            OutSplineMesh->SetRelativeLocation(FVector::ZeroVector); // Needs to be unset in this config
-            const FRotator currentIndexCoordSystem            = SplineComponent->GetDirectionAtSplinePoint(Index, LocalSpace).Rotation();
-            const FRotator nextIndexCoordSystem               = SplineComponent->GetDirectionAtSplinePoint(nextIndex, LocalSpace).Rotation();
-            const FVector rotatedMeshInitLocationCurrentIndex = currentIndexCoordSystem.RotateVector(MeshInitData.LocationInfo.Location);
-            const FVector rotatedMeshInitLocationNextIndex    = nextIndexCoordSystem.RotateVector(MeshInitData.LocationInfo.Location);
-            startLocation += (rotatedMeshInitLocationCurrentIndex + randomVectorCurrentIndex);
-            endLocation   += (rotatedMeshInitLocationNextIndex    + randomVectorNextIndex);
-        }
-        else if (MeshInitData.LocationInfo.CoordinateSystem == EFlexCoordinateSystem::SplineSystem)
+    // Reuse the most recently released component of the same class, if any. Skip entries
+    // that were destroyed externally or nulled out by the garbage collector
+    FFlexComponentPoolBucket* bucket = ComponentPool.Find(ComponentClass);
+    while (bucket && bucket->Components.Num() > 0 && !component)
+    {
+        USceneComponent* pooled = bucket->Components.Pop(false);
+        if (pooled && !pooled->IsPendingKill())
         {
-            OutSplineMesh->SetRelativeLocation(MeshInitData.LocationInfo.Location + randomVectorCurrentIndex);
+            component = pooled;
         }
-
-        OutSplineMesh->SetStartAndEnd(startLocation, startTangent, endLocation, endTangent);
-        OutSplineMesh->SetStartOffset(bSync ? previousPointData.EndOffset : pointData.StartOffset);
-        OutSplineMesh->SetEndOffset(pointData.EndOffset);
     }
-}
-
-UStaticMeshComponent* AFlexSplineActor::CreateMeshComponent(UClass* MeshType, FSplineMeshInitData& MeshInitData, int32 Index /*= -1*/)
-{
-    UStaticMeshComponent* newMesh = NewObject<UStaticMeshComponent>(this, MeshType);
-    newMesh->RegisterComponent();
-    newMesh->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
 
-    if (Index < 0)
+    if (component)
     {
-        MeshInitData.MeshComponentsArray.Add(newMesh);
+        component->RegisterComponent();
+        LastConstructionTimings.NumReusedComponents++;
+        INC_DWORD_STAT(STAT_FlexSplineComponentsReused);
     }
     else
     {
-        MeshInitData.MeshComponentsArray.Insert(newMesh, Index);
+        component = NewObject<USceneComponent>(this, ComponentClass);
+        component->RegisterComponent();
+        component->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
+        LastConstructionTimings.NumCreatedComponents++;
+        INC_DWORD_STAT(STAT_FlexSplineComponentsCreated);
     }
 
-    return newMesh;
+    return component;
 }
 
-UArrowComponent* AFlexSplineActor::CreateArrrowComponent(FSplineMeshInitData& MeshInitData)
+void AFlexSplineActor::ReleaseComponent(USceneComponent* Component)
 {
-    UArrowComponent* newArrow = NewObject<UArrowComponent>(RootComponent);
-    newArrow->RegisterComponent();
-    newArrow->AttachToComponent(RootComponent, FAttachmentTransformRules::KeepRelativeTransform);
-    newArrow->SetHiddenInGame(true);
-    newArrow->ArrowSize = UpDirectionArrowSize;
-    MeshInitData.ArrowSplineUpIndicatorArray.Add(newArrow);
-
-    return newArrow;
+    if (Component)
+    {
+        FFlexComponentPoolBucket& bucket = ComponentPool.FindOrAdd(Component->GetClass());
+        if (bucket.Components.Num() < CVarMaxPooledComponents.GetValueOnGameThread())
+        {
+            Component->UnregisterComponent();
+            bucket.Components.Add(Component);
+            INC_DWORD_STAT(STAT_FlexSplineComponentsPooled);
+        }
+        else
+        {
+            Component->DestroyComponent();
+            INC_DWORD_STAT(STAT_FlexSplineComponentsDestroyed);
+        }
+    }
 }
@@ -0,0 +1,174 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#include "FlexSplinePrivatePCH.h"
+#include "FlexSplineBatchKernels.h"
+
+/** Meshes composed together in one set of vector registers */
+static const int32 LaneCount = 4;
+
+/** Gather one float member of four consecutive entries into the lanes of a register */
+#define GATHER_LANES(Array, Base, Member) \
+    MakeVectorRegister((Array)[(Base)].Member, (Array)[(Base) + 1].Member, (Array)[(Base) + 2].Member, (Array)[(Base) + 3].Member)
+
+static FORCEINLINE VectorRegister LoadVector(const FlexSplineMath::FFlexMathVector& Vector)
+{
+    return MakeVectorRegister(Vector.X, Vector.Y, Vector.Z, 0.f);
+}
+
+static FORCEINLINE VectorRegister LoadRotator(const FlexSplineMath::FFlexMathRotator& Rotator)
+{
+    return MakeVectorRegister(Rotator.Pitch, Rotator.Yaw, Rotator.Roll, 0.f);
+}
+
+/** Rotate offsets of four meshes into the coordinate systems of their spline points and add their frame locations */
+static void ComposePointLocalLocations(const VectorRegister& LayerLocation, const FFlexTransformStreams& In, int32 Base, FVector* OutLocations)
+{
+    const VectorRegister degreesToRadians = VectorSetFloat1(PI / 180.f);
+    const FRotator* directions            = In.FrameDirectionRotations;
+
+    VectorRegister sp, cp, sy, cy, sr, cr;
+    const VectorRegister pitch = VectorMultiply(GATHER_LANES(directions, Base, Pitch), degreesToRadians);
+    const VectorRegister yaw   = VectorMultiply(GATHER_LANES(directions, Base, Yaw),   degreesToRadians);
+    const VectorRegister roll  = VectorMultiply(GATHER_LANES(directions, Base, Roll),  degreesToRadians);
+    VectorSinCos(&sp, &cp, &pitch);
+    VectorSinCos(&sy, &cy, &yaw);
+    VectorSinCos(&sr, &cr, &roll);
+
+    // Rows of FRotationMatrix, one mesh per lane
+    const VectorRegister spcy = VectorMultiply(sp, cy);
+    const VectorRegister spsy = VectorMultiply(sp, sy);
+    const VectorRegister m00  = VectorMultiply(cp, cy);
+    const VectorRegister m01  = VectorMultiply(cp, sy);
+    const VectorRegister m02  = sp;
+    const VectorRegister m10  = VectorSubtract(VectorMultiply(sr, spcy), VectorMultiply(cr, sy));
+    const VectorRegister m11  = VectorMultiplyAdd(sr, spsy, VectorMultiply(cr, cy));
+    const VectorRegister m12  = VectorNegate(VectorMultiply(sr, cp));
+    const VectorRegister m20  = VectorNegate(VectorMultiplyAdd(cr, spcy, VectorMultiply(sr, sy)));
+    const VectorRegister m21  = VectorSubtract(VectorMultiply(cy, sr), VectorMultiply(cr, spsy));
+    const VectorRegister m22  = VectorMultiply(cr, cp);
+
+    // All offsets share the rotation, so they are summed before rotating
+    const VectorRegister offsetX = VectorAdd(VectorAdd(VectorReplicate(LayerLocation, 0), GATHER_LANES(In.PointLocations, Base, X)), GATHER_LANES(In.RandomLocations, Base, X));
+    const VectorRegister offsetY = VectorAdd(VectorAdd(VectorReplicate(LayerLocation, 1), GATHER_LANES(In.PointLocations, Base, Y)), GATHER_LANES(In.RandomLocations, Base, Y));
+    const VectorRegister offsetZ = VectorAdd(VectorAdd(VectorReplicate(LayerLocation, 2), GATHER_LANES(In.PointLocations, Base, Z)), GATHER_LANES(In.RandomLocations, Base, Z));
+
+    const VectorRegister x = VectorMultiplyAdd(offsetX, m00, VectorMultiplyAdd(offsetY, m10, VectorMultiplyAdd(offsetZ, m20, GATHER_LANES(In.FrameLocations, Base, X))));
+    const VectorRegister y = VectorMultiplyAdd(offsetX, m01, VectorMultiplyAdd(offsetY, m11, VectorMultiplyAdd(offsetZ, m21, GATHER_LANES(In.FrameLocations, Base, Y))));
+    const VectorRegister z = VectorMultiplyAdd(offsetX, m02, VectorMultiplyAdd(offsetY, m12, VectorMultiplyAdd(offsetZ, m22, GATHER_LANES(In.FrameLocations, Base, Z))));
+
+    float lanesX[LaneCount], lanesY[LaneCount], lanesZ[LaneCount];
+    VectorStore(x, lanesX);
+    VectorStore(y, lanesY);
+    VectorStore(z, lanesZ);
+    for (int32 lane = 0; lane < LaneCount; lane++)
+    {
+        OutLocations[Base + lane] = FVector(lanesX[lane], lanesY[lane], lanesZ[lane]);
+    }
+}
+
+void FlexSplineBatchKernels::ComposeStaticMeshTransforms(const FlexSplineMath::FFlexMathPlacement& Placement, const FFlexTransformStreams& In, const FFlexTransformOutputs& Out)
+{
+    const VectorRegister layerLocation = LoadVector(Placement.Location);
+    const VectorRegister layerRotation = LoadRotator(Placement.Rotation);
+    const VectorRegister layerScale    = LoadVector(Placement.Scale);
+
+    // Locations, point local ones are rotated in groups of four meshes
+    int32 numComposed = 0;
+    if (Placement.bLocationLocalToPoint)
+    {
+        for (; numComposed + LaneCount <= In.Num; numComposed += LaneCount)
+        {
+            ComposePointLocalLocations(layerLocation, In, numComposed, Out.Locations);
+        }
+    }
+    for (int32 index = numComposed; index < In.Num; index++)
+    {
+        if (Placement.bLocationLocalToPoint)
+        {
+            // Remaining meshes of an incomplete group
+            Out.Locations[index] = FromMath(FlexSplineMath::ComputeLocation(Placement, ToMath(In.FrameLocations[index]), ToMath(In.FrameDirectionRotations[index]),
+                                                                            ToMath(In.PointLocations[index]), ToMath(In.RandomLocations[index])));
+        }
+        else
+        {
+            // Spline local offsets are a plain sum, without any trigonometry
+            const VectorRegister offset = VectorAdd(VectorLoadFloat3_W0(&In.PointLocations[index]), VectorLoadFloat3_W0(&In.RandomLocations[index]));
+            VectorStoreFloat3(VectorAdd(VectorLoadFloat3_W0(&In.FrameLocations[index]), VectorAdd(layerLocation, offset)), &Out.Locations[index]);
+        }
+    }
+
+    // Rotations, the spline point's rotation only contributes if the layer is point local
+    for (int32 index = 0; index < In.Num; index++)
+    {
+        VectorRegister rotation = VectorAdd(layerRotation, VectorAdd(VectorLoadFloat3_W0(&In.RandomRotations[index]), VectorLoadFloat3_W0(&In.PointRotations[index])));
+        if (Placement.bRotationLocalToPoint)
+        {
+            rotation = VectorAdd(rotation, VectorLoadFloat3_W0(&In.FrameRotations[index]));
+        }
+        VectorStoreFloat3(rotation, &Out.Rotations[index]);
+    }
+
+    // Scales
+    for (int32 index = 0; index < In.Num; index++)
+    {
+        const VectorRegister offset = VectorAdd(VectorLoadFloat3_W0(&In.PointScales[index]), VectorLoadFloat3_W0(&In.RandomScales[index]));
+        VectorStoreFloat3(VectorMultiplyAdd(layerScale, VectorLoadFloat3_W0(&In.FrameScales[index]), offset), &Out.Scales[index]);
+    }
+}
+
+void FlexSplineBatchKernels::ComposeStaticMeshTransformsScalar(const FlexSplineMath::FFlexMathPlacement& Placement, const FFlexTransformStreams& In, const FFlexTransformOutputs& Out)
+{
+    using namespace FlexSplineMath;
+    ComputeLocations(Placement,
+                     reinterpret_cast<const FFlexMathVector*>(In.FrameLocations),
+                     reinterpret_cast<const FFlexMathRotator*>(In.FrameDirectionRotations),
+                     reinterpret_cast<const FFlexMathVector*>(In.PointLocations),
+                     reinterpret_cast<const FFlexMathVector*>(In.RandomLocations),
+                     In.Num, reinterpret_cast<FFlexMathVector*>(Out.Locations));
+    ComputeRotations(Placement,
+                     reinterpret_cast<const FFlexMathRotator*>(In.FrameRotations),
+                     reinterpret_cast<const FFlexMathRotator*>(In.PointRotations),
+                     reinterpret_cast<const FFlexMathRotator*>(In.RandomRotations),
+                     In.Num, reinterpret_cast<FFlexMathRotator*>(Out.Rotations));
+    ComputeScales(Placement,
+                  reinterpret_cast<const FFlexMathVector*>(In.FrameScales),
+                  reinterpret_cast<const FFlexMathVector*>(In.PointScales),
+                  reinterpret_cast<const FFlexMathVector*>(In.RandomScales),
+                  In.Num, reinterpret_cast<FFlexMathVector*>(Out.Scales));
+}
+
+/** Deviation of @param Value from @param Reference, relative to the reference unless it is close to zero */
+static float GetDeviation(const FVector& Value, const FVector& Reference)
+{
+    return (Value - Reference).GetAbsMax() / FMath::Max(1.f, Reference.GetAbsMax());
+}
+
+float FlexSplineBatchKernels::VerifyStaticMeshTransforms(const FlexSplineMath::FFlexMathPlacement& Placement, const FFlexTransformStreams& In, const FFlexTransformOutputs& Out)
+{
+    TArray<FVector> locations, scales;
+    TArray<FRotator> rotations;
+    locations.SetNumUninitialized(In.Num);
+    rotations.SetNumUninitialized(In.Num);
+    scales.SetNumUninitialized(In.Num);
+
+    const FFlexTransformOutputs reference = { locations.GetData(), rotations.GetData(), scales.GetData() };
+    ComposeStaticMeshTransformsScalar(Placement, In, reference);
+
+    float maxDeviation = 0.f;
+    for (int32 index = 0; index < In.Num; index++)
+    {
+        maxDeviation = FMath::Max(maxDeviation, GetDeviation(Out.Locations[index], locations[index]));
+        maxDeviation = FMath::Max(maxDeviation, GetDeviation(Out.Rotations[index].Euler(), rotations[index].Euler()));
+        maxDeviation = FMath::Max(maxDeviation, GetDeviation(Out.Scales[index], scales[index]));
+    }
+
+    return maxDeviation;
+}
+
+#undef GATHER_LANES
@@ -0,0 +1,80 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#pragma once
+
+#include "FlexSplineMath.h"
+
+static_assert(sizeof(FVector) == sizeof(FlexSplineMath::FFlexMathVector), "FFlexMathVector must match the layout of FVector");
+static_assert(sizeof(FRotator) == sizeof(FlexSplineMath::FFlexMathRotator), "FFlexMathRotator must match the layout of FRotator");
+
+/** Conversions between engine types and those of the math core, which share their layout */
+FORCEINLINE const FlexSplineMath::FFlexMathVector& ToMath(const FVector& Vector)
+{
+    return reinterpret_cast<const FlexSplineMath::FFlexMathVector&>(Vector);
+}
+
+FORCEINLINE const FlexSplineMath::FFlexMathRotator& ToMath(const FRotator& Rotator)
+{
+    return reinterpret_cast<const FlexSplineMath::FFlexMathRotator&>(Rotator);
+}
+
+FORCEINLINE FVector FromMath(const FlexSplineMath::FFlexMathVector& Vector)
+{
+    return FVector(Vector.X, Vector.Y, Vector.Z);
+}
+
+FORCEINLINE FRotator FromMath(const FlexSplineMath::FFlexMathRotator& Rotator)
+{
+    return FRotator(Rotator.Pitch, Rotator.Yaw, Rotator.Roll);
+}
+
+/** Inputs of a batch of static meshes, as parallel arrays with one entry per mesh */
+struct FFlexTransformStreams
+{
+    const FVector* FrameLocations;
+    const FRotator* FrameDirectionRotations;
+    const FRotator* FrameRotations;
+    const FVector* FrameScales;
+
+    const FVector* PointLocations;
+    const FRotator* PointRotations;
+    const FVector* PointScales;
+
+    const FVector* RandomLocations;
+    const FRotator* RandomRotations;
+    const FVector* RandomScales;
+
+    int32 Num;
+};
+
+/** Composed transforms of a batch of static meshes, parallel to FFlexTransformStreams */
+struct FFlexTransformOutputs
+{
+    FVector* Locations;
+    FRotator* Rotations;
+    FVector* Scales;
+};
+
+namespace FlexSplineBatchKernels
+{
+    /**
+    * Compose locations, rotations and scales of a whole batch with vector registers. Point local locations are
+    * rotated four meshes at a time, spline local ones skip all trigonometry
+    */
+    void ComposeStaticMeshTransforms(const FlexSplineMath::FFlexMathPlacement& Placement, const FFlexTransformStreams& In, const FFlexTransformOutputs& Out);
+
+    /** Reference implementation of ComposeStaticMeshTransforms, one mesh at a time with the scalar math core */
+    void ComposeStaticMeshTransformsScalar(const FlexSplineMath::FFlexMathPlacement& Placement, const FFlexTransformStreams& In, const FFlexTransformOutputs& Out);
+
+    /**
+    * Compare @param Out against the scalar reference for the same inputs. Tolerance is relative to each value's magnitude,
+    * since vectorized trigonometry rounds differently. @return Largest deviation found
+    */
+    float VerifyStaticMeshTransforms(const FlexSplineMath::FFlexMathPlacement& Placement, const FFlexTransformStreams& In, const FFlexTransformOutputs& Out);
+}
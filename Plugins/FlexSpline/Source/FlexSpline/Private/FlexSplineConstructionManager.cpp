@@ -0,0 +1,117 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#include "FlexSplinePrivatePCH.h"
+#include "FlexSplineConstructionManager.h"
+#include "FlexSplineActor.h"
+#include "HAL/IConsoleManager.h"
+
+static TAutoConsoleVariable<float> CVarConstructionBudgetMs(
+    TEXT("flexspline.ConstructionBudgetMs"),
+    2.f,
+    TEXT("Time in milliseconds time-sliced Flex Splines may spend building meshes per frame. 0: Build at once"),
+    ECVF_Default);
+
+FFlexSplineConstructionManager* FFlexSplineConstructionManager::Instance = nullptr;
+
+//////////////////////////////////////////////////////////////////////////
+// STATIC HELPERS
+static float GetViewerDistanceSquared(const AFlexSplineActor* FlexSpline)
+{
+    const UWorld* world = FlexSpline->GetWorld();
+    if (!world || world->ViewLocationsRenderedLastFrame.Num() == 0)
+    {
+        return 0.f;
+    }
+
+    float distanceSquared = MAX_flt;
+    for (const FVector& viewLocation : world->ViewLocationsRenderedLastFrame)
+    {
+        distanceSquared = FMath::Min(distanceSquared, FVector::DistSquared(FlexSpline->GetActorLocation(), viewLocation));
+    }
+    return distanceSquared;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// LIFETIME
+void FFlexSplineConstructionManager::Startup()
+{
+    check(!Instance);
+    Instance = new FFlexSplineConstructionManager();
+}
+
+void FFlexSplineConstructionManager::Shutdown()
+{
+    delete Instance;
+    Instance = nullptr;
+}
+
+bool FFlexSplineConstructionManager::IsEnabled()
+{
+    return Instance && (CVarConstructionBudgetMs.GetValueOnGameThread() > 0.f);
+}
+
+FFlexSplineConstructionManager& FFlexSplineConstructionManager::Get()
+{
+    check(Instance);
+    return *Instance;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// CONSTRUCTION
+void FFlexSplineConstructionManager::Enqueue(AFlexSplineActor* FlexSpline)
+{
+    PendingSplines.AddUnique(FlexSpline);
+}
+
+void FFlexSplineConstructionManager::Tick(float DeltaTime)
+{
+    const double endTime = FPlatformTime::Seconds() + CVarConstructionBudgetMs.GetValueOnGameThread() / 1000.0;
+
+    // Destroyed Flex Splines are simply dropped, the nearest ones are built first
+    PendingSplines.RemoveAll([](const TWeakObjectPtr<AFlexSplineActor>& FlexSpline)
+    {
+        return !FlexSpline.IsValid();
+    });
+    PendingSplines.Sort([](const TWeakObjectPtr<AFlexSplineActor>& A, const TWeakObjectPtr<AFlexSplineActor>& B)
+    {
+        return GetViewerDistanceSquared(A.Get()) < GetViewerDistanceSquared(B.Get());
+    });
+
+    // Completion broadcasts may rebuild Flex Splines, which queues them again. Iterate over a copy
+    // and only drop those that have nothing pending afterwards
+    const TArray<TWeakObjectPtr<AFlexSplineActor>> pendingSplines = PendingSplines;
+    for (const TWeakObjectPtr<AFlexSplineActor>& flexSpline : pendingSplines)
+    {
+        if (flexSpline.IsValid() && flexSpline->IsConstructionPending())
+        {
+            flexSpline->ProcessPendingSegments(endTime);
+        }
+        if (!flexSpline.IsValid() || !flexSpline->IsConstructionPending())
+        {
+            PendingSplines.Remove(flexSpline);
+        }
+
+        if (FPlatformTime::Seconds() >= endTime)
+        {
+            break;
+        }
+    }
+}
+
+bool FFlexSplineConstructionManager::IsTickable() const
+{
+    return PendingSplines.Num() > 0;
+}
+
+TStatId FFlexSplineConstructionManager::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(FFlexSplineConstructionManager, STATGROUP_FlexSpline);
+}
@@ -0,0 +1,47 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#pragma once
+
+#include "Tickable.h"
+
+class AFlexSplineActor;
+
+/**
+* Builds meshes of time-sliced Flex Splines across several frames, within a fixed time budget per frame.
+* Flex Splines closest to a viewer are processed first. Owned by the FlexSpline module
+*/
+class FFlexSplineConstructionManager : public FTickableGameObject
+{
+public:
+
+    /** Create or destroy the manager, called on module startup and shutdown */
+    static void Startup();
+    static void Shutdown();
+
+    /** Is there a manager with a time budget? If not, Flex Splines are built at once */
+    static bool IsEnabled();
+
+    static FFlexSplineConstructionManager& Get();
+
+    /** Process pending segments of @param FlexSpline on upcoming frames, until it reports completion */
+    void Enqueue(AFlexSplineActor* FlexSpline);
+
+    /** FTickableGameObject interface */
+    void Tick(float DeltaTime) override;
+    bool IsTickable() const override;
+    TStatId GetStatId() const override;
+
+
+private:
+
+    /** Flex Splines with pending segments, in no particular order */
+    TArray<TWeakObjectPtr<AFlexSplineActor>> PendingSplines;
+
+    static FFlexSplineConstructionManager* Instance;
+};
@@ -0,0 +1,17 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#include "FlexSplinePrivatePCH.h"
+#include "FlexSplineDebugComponent.h"
+
+UFlexSplineDebugComponent::UFlexSplineDebugComponent()
+    : Super()
+{
+    PrimaryComponentTick.bCanEverTick = false;
+    bIsEditorOnly                     = true;
+}
@@ -0,0 +1,43 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#include "FlexSplinePrivatePCH.h"
+#include "FlexSplineLayerPreset.h"
+#include "UObject/UObjectIterator.h"
+
+UFlexSplineLayerPreset::UFlexSplineLayerPreset()
+    : Super()
+{
+}
+
+#if WITH_EDITOR
+void UFlexSplineLayerPreset::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+    Super::PostEditChangeProperty(PropertyChangedEvent);
+
+    // Init new entries from template
+    for (auto& layerPair : Layers)
+    {
+        if (!layerPair.Value.IsInitialized())
+        {
+            layerPair.Value = LayerTemplate;
+            layerPair.Value.Initialize();
+        }
+    }
+
+    // Only Flex Splines referencing this preset rebuild, and their layer hashes limit mesh updates to the layers that changed
+    for (TObjectIterator<AFlexSplineActor> flexSplineIt; flexSplineIt; ++flexSplineIt)
+    {
+        AFlexSplineActor* flexSpline = *flexSplineIt;
+        if (flexSpline->GetLayerPreset() == this && !flexSpline->IsTemplate() && flexSpline->GetWorld())
+        {
+            flexSpline->Rebuild();
+        }
+    }
+}
+#endif
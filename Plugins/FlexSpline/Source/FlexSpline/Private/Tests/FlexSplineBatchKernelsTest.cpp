@@ -0,0 +1,98 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+
+#include "FlexSplinePrivatePCH.h"
+#include "FlexSplineBatchKernels.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Largest relative deviation of the vectorized kernels from the scalar reference, VectorSinCos rounds differently */
+static const float MaxKernelDeviation = 1.e-3f;
+
+/** Angles of several full turns, beyond the range VectorSinCos maps back to [-pi, pi] */
+static const float MaxTestAngle = 3600.f;
+
+static FVector RandomVector(FRandomStream& Stream, float Range)
+{
+    return FVector(Stream.FRandRange(-Range, Range), Stream.FRandRange(-Range, Range), Stream.FRandRange(-Range, Range));
+}
+
+static FRotator RandomRotator(FRandomStream& Stream, float Range)
+{
+    return FRotator(Stream.FRandRange(-Range, Range), Stream.FRandRange(-Range, Range), Stream.FRandRange(-Range, Range));
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlexSplineBatchKernelsTest, "FlexSpline.BatchKernels.ComposeStaticMeshTransforms",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFlexSplineBatchKernelsTest::RunTest(const FString& Parameters)
+{
+    // Full groups of lanes, partial ones and batches with only a partial group
+    const int32 meshCounts[] = { 1, 3, 4, 5, 7, 64, 255, 256 };
+
+    for (int32 seed = 0; seed < 4; seed++)
+    {
+        for (const int32 numMeshes : meshCounts)
+        {
+            FRandomStream stream(seed * 1000 + numMeshes);
+
+            TArray<FVector> frameLocations, frameScales, pointLocations, pointScales, randomLocations, randomScales;
+            TArray<FRotator> frameDirectionRotations, frameRotations, pointRotations, randomRotations;
+            for (int32 index = 0; index < numMeshes; index++)
+            {
+                frameLocations.Add(RandomVector(stream, 100000.f));
+                frameDirectionRotations.Add(RandomRotator(stream, MaxTestAngle));
+                frameRotations.Add(RandomRotator(stream, MaxTestAngle));
+                frameScales.Add(RandomVector(stream, 4.f));
+                pointLocations.Add(RandomVector(stream, 500.f));
+                pointRotations.Add(RandomRotator(stream, 360.f));
+                pointScales.Add(RandomVector(stream, 1.f));
+                randomLocations.Add(RandomVector(stream, 100.f));
+                randomRotations.Add(RandomRotator(stream, 180.f));
+                randomScales.Add(RandomVector(stream, 0.5f));
+            }
+
+            TArray<FVector> locations, scales;
+            TArray<FRotator> rotations;
+            locations.SetNumUninitialized(numMeshes);
+            rotations.SetNumUninitialized(numMeshes);
+            scales.SetNumUninitialized(numMeshes);
+
+            const FFlexTransformStreams in = { frameLocations.GetData(), frameDirectionRotations.GetData(), frameRotations.GetData(), frameScales.GetData(),
+                                               pointLocations.GetData(), pointRotations.GetData(), pointScales.GetData(),
+                                               randomLocations.GetData(), randomRotations.GetData(), randomScales.GetData(), numMeshes };
+            const FFlexTransformOutputs out = { locations.GetData(), rotations.GetData(), scales.GetData() };
+
+            // All combinations of point and spline local locations and rotations
+            for (int32 localMask = 0; localMask < 4; localMask++)
+            {
+                FlexSplineMath::FFlexMathPlacement placement;
+                placement.bLocationLocalToPoint    = (localMask & 1) != 0;
+                placement.bRotationLocalToPoint    = (localMask & 2) != 0;
+                placement.bUpDirectionLocalToPoint = false;
+                placement.Location                 = ToMath(RandomVector(stream, 1000.f));
+                placement.Rotation                 = ToMath(RandomRotator(stream, MaxTestAngle));
+                placement.Scale                    = ToMath(RandomVector(stream, 2.f));
+                placement.UpDirection              = ToMath(FVector::UpVector);
+
+                FlexSplineBatchKernels::ComposeStaticMeshTransforms(placement, in, out);
+                const float deviation = FlexSplineBatchKernels::VerifyStaticMeshTransforms(placement, in, out);
+                TestTrue(FString::Printf(TEXT("Seed %d, %d meshes, location %s, rotation %s: deviation %f"), seed, numMeshes,
+                                         placement.bLocationLocalToPoint ? TEXT("point local") : TEXT("spline local"),
+                                         placement.bRotationLocalToPoint ? TEXT("point local") : TEXT("spline local"), deviation),
+                         deviation <= MaxKernelDeviation);
+            }
+        }
+    }
+
+    return true;
+}
+
+#endif
@@ -0,0 +1,103 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+
+
+#include "FlexSplinePrivatePCH.h"
+#include "FlexSplineActor.h"
+#include "Components/SplineComponent.h"
+#include "Engine/Engine.h"
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+/** Spline points A, B, C and D, spaced along X */
+static const int32 NumTestPoints    = 4;
+static const float TestPointSpacing = 100.f;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FFlexSplinePointDiffTest, "FlexSpline.PointDiff.PointDataFollowsSplinePoints",
+                                 EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::EngineFilter)
+
+bool FFlexSplinePointDiffTest::RunTest(const FString& Parameters)
+{
+    // Editor worlds never time-slice construction, so every rebuild completes at once
+    UWorld* world               = UWorld::CreateWorld(EWorldType::Editor, false);
+    FWorldContext& worldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+    worldContext.SetCurrentWorld(world);
+
+    // Every point gets its own end roll, so point data can be told apart after edits
+    TArray<int32> originalIDs;
+    auto spawnFlexSpline = [&]()
+    {
+        TArray<FVector> points;
+        for (int32 index = 0; index < NumTestPoints; index++)
+        {
+            points.Add(FVector(index * TestPointSpacing, 0.f, 0.f));
+        }
+
+        AFlexSplineActor* flexSpline = world->SpawnActor<AFlexSplineActor>();
+        flexSpline->SplineComponent->SetSplinePoints(points, ESplineCoordinateSpace::Local, true);
+        flexSpline->Rebuild();
+        for (int32 index = 0; index < NumTestPoints; index++)
+        {
+            flexSpline->PointData.SetEndRoll(index, index + 1.f);
+        }
+        originalIDs = flexSpline->PointData.PointIDs;
+        return flexSpline;
+    };
+
+    // @param ExpectedPoints are indices of the original points whose data each spline point should have
+    auto testPointData = [&](const TCHAR* Case, const AFlexSplineActor* FlexSpline, const TArray<int32>& ExpectedPoints)
+    {
+        if (!TestEqual(FString::Printf(TEXT("%s: number of points"), Case), FlexSpline->PointData.Num(), ExpectedPoints.Num()))
+        {
+            return;
+        }
+        for (int32 index = 0; index < ExpectedPoints.Num(); index++)
+        {
+            TestEqual(FString::Printf(TEXT("%s: point %d identifier"), Case, index), FlexSpline->PointData.PointIDs[index], originalIDs[ExpectedPoints[index]]);
+            TestEqual(FString::Printf(TEXT("%s: point %d end roll"), Case, index), FlexSpline->PointData.GetEndRoll(index), ExpectedPoints[index] + 1.f);
+        }
+    };
+
+    // Delete B and move C in one transaction, C keeps its data and B's data is dropped
+    {
+        AFlexSplineActor* flexSpline = spawnFlexSpline();
+        flexSpline->NotifySplinePointRemoved(1);
+        flexSpline->SplineComponent->RemoveSplinePoint(1, false);
+        flexSpline->SplineComponent->SetLocationAtSplinePoint(1, FVector(250.f, 50.f, 0.f), ESplineCoordinateSpace::Local, true);
+        flexSpline->Rebuild();
+        testPointData(TEXT("Delete and move"), flexSpline, { 0, 2, 3 });
+        flexSpline->Destroy();
+    }
+
+    // Move A onto C's old location and C away, no data changes hands or gets dropped
+    {
+        AFlexSplineActor* flexSpline = spawnFlexSpline();
+        flexSpline->SplineComponent->SetLocationAtSplinePoint(0, FVector(2.f * TestPointSpacing, 0.f, 0.f), ESplineCoordinateSpace::Local, false);
+        flexSpline->SplineComponent->SetLocationAtSplinePoint(2, FVector(5.f * TestPointSpacing, 0.f, 0.f), ESplineCoordinateSpace::Local, true);
+        flexSpline->Rebuild();
+        testPointData(TEXT("Move onto old location"), flexSpline, { 0, 1, 2, 3 });
+        flexSpline->Destroy();
+    }
+
+    // Unreported deletions fall back to matching by location
+    {
+        AFlexSplineActor* flexSpline = spawnFlexSpline();
+        flexSpline->SplineComponent->RemoveSplinePoint(1, true);
+        flexSpline->Rebuild();
+        testPointData(TEXT("Unreported delete"), flexSpline, { 0, 2, 3 });
+        flexSpline->Destroy();
+    }
+
+    GEngine->DestroyWorldContext(world);
+    world->DestroyWorld(false);
+    return true;
+}
+
+#endif
@@ -13,7 +13,9 @@
 #include "FlexSplineActor.generated.h"
 
 using WeakStaticMeshComp = TWeakObjectPtr<class UStaticMeshComponent>;
-using WeakArrowComp      = TWeakObjectPtr<class UArrowComponent>;
+using WeakInstancedComp  = TWeakObjectPtr<class UHierarchicalInstancedStaticMeshComponent>;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FFlexSplineConstructionCompleted, class AFlexSplineActor*, FlexSpline);
 
 
 /** Generic (XYZ - )Axis Type */
@@ -57,6 +59,26 @@ enum class EFlexSplineMeshType : uint8
     , StaticMesh
 };
 
+/** Where along the spline are the meshes of a layer placed */
+UENUM(BlueprintType)
+enum class EFlexPlacementMode : uint8
+{
+    /** One mesh per spline point */
+      SplinePoints
+    /** Meshes are spread evenly by distance along the spline, independent of spline points */
+    , Distance
+};
+
+/** What the time axis of parameter curves is measured in */
+UENUM(BlueprintType)
+enum class EFlexCurveDomain : uint8
+{
+    /** Distance along the spline, normalized to 0 at its start and 1 at its end */
+      Distance
+    /** Input key of the spline, i.e. the spline point index. Fractions lie in between spline points */
+    , InputKey
+};
+
 /** At what place of the spline should a mesh be rendered */
 UENUM(BlueprintType, meta = (Bitflags))
 enum class EFlexSplineRenderMode : uint8
@@ -69,6 +91,8 @@ enum class EFlexSplineRenderMode : uint8
     , Middle
     /** Every spline point specified by "Render Mode Custom Indices" */
     , Custom
+    /** Every spline point selected by "Render Ranges" */
+    , Ranges
 };
 
 /** Controls miscellaneous settings of mesh layers */
@@ -103,14 +127,45 @@ struct FFlexMeshInfo
     UPROPERTY(EditAnywhere, Category = FlexSpline)
     UMaterialInterface* MeshMaterial;
 
+    /** Render all static meshes of this layer as instances of a single component. Only relevant for static meshes */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    uint32 bUseInstancing : 1;
+
     FFlexMeshInfo(EFlexSplineAxis InForwardAxis = EFlexSplineAxis::X, EFlexSplineMeshType InType = EFlexSplineMeshType::SplineMesh)
         : MeshType(InType)
         , MeshForwardAxis(InForwardAxis)
         , Mesh(nullptr)
         , MeshMaterial(nullptr)
+        , bUseInstancing(false)
         { }
 };
 
+/** Selects every Nth spline point within a range of indices */
+USTRUCT(BlueprintType)
+struct FFlexRenderRange
+{
+    GENERATED_BODY()
+
+    /** First spline point index of the range */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0"))
+    int32 Start;
+
+    /** Last spline point index of the range, inclusive. Negative values count back from the end, -1 being the last point */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    int32 End;
+
+    /** Select every Nth spline point, beginning with the first one of the range */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "1"))
+    int32 Step;
+
+    FFlexRenderRange(int32 InStart = 0, int32 InEnd = -1, int32 InStep = 1)
+        : Start(InStart)
+        , End(InEnd)
+        , Step(InStep)
+    {
+    }
+};
+
 USTRUCT(BlueprintType)
 struct FFlexRenderInfo
 {
@@ -132,6 +187,10 @@ struct FFlexRenderInfo
     UPROPERTY(EditAnywhere, Category = FlexSpline)
     TSet<uint32> RenderModeCustomIndices;
 
+    /** Define index ranges in which to render the mesh. Only used if "Ranges" Render Mode is active */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    TArray<FFlexRenderRange> RenderRanges;
+
     FFlexRenderInfo(float InSpawnChance = 1.f, bool bInRandomizeSpawnChance = true)
         : bRandomizeSpawnChance(bInRandomizeSpawnChance)
         , SpawnChance(InSpawnChance)
@@ -143,6 +202,39 @@ struct FFlexRenderInfo
     }
 };
 
+USTRUCT(BlueprintType)
+struct FFlexPlacementInfo
+{
+    GENERATED_BODY()
+
+    /**
+    * Place meshes at spline points or every "Spacing" units along the spline. Only relevant for static meshes.
+    * Render modes select the segments between spline points that receive meshes, spawn chance applies per mesh
+    */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    EFlexPlacementMode Mode;
+
+    /** Distance along the spline between two meshes */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "1.0", UIMax = "5000.0"))
+    float Spacing;
+
+    /** Distance along the spline of the first mesh */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0.0", UIMax = "5000.0"))
+    float StartDistance;
+
+    /** Randomly move each mesh along the spline by up to this fraction of the spacing, seeded */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0.0", ClampMax = "0.5"))
+    float SpacingJitter;
+
+    FFlexPlacementInfo()
+        : Mode(EFlexPlacementMode::SplinePoints)
+        , Spacing(100.f)
+        , StartDistance(0.f)
+        , SpacingJitter(0.f)
+    {
+    }
+};
+
 USTRUCT(BlueprintType)
 struct FFlexPhysicsInfo
 {
@@ -170,6 +262,51 @@ struct FFlexPhysicsInfo
     }
 };
 
+USTRUCT(BlueprintType)
+struct FFlexRenderCostInfo
+{
+    GENERATED_BODY()
+
+    /** Meshes closer to the camera than this are not drawn */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0.0", UIMax = "10000.0"))
+    float MinDrawDistance;
+
+    /** Meshes further away from the camera than this are not drawn. 0 draws at any distance */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0.0", UIMax = "50000.0"))
+    float MaxDrawDistance;
+
+    /** Should meshes of this layer cast shadows at all? */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    uint32 bCastShadow : 1;
+
+    /** Should meshes of this layer cast dynamic shadows? Requires bCastShadow */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    uint32 bCastDynamicShadow : 1;
+
+    /** Always render this LOD, counting from 1. 0 selects LODs by screen size */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0"))
+    int32 ForcedLodModel;
+
+    /** Skips all LODs below this one, reducing detail regardless of screen size */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0"))
+    int32 MinLOD;
+
+    /** Meshes of this layer are only created if the detail mode of the platform is at least this high */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    TEnumAsByte<EDetailMode> DetailMode;
+
+    FFlexRenderCostInfo()
+        : MinDrawDistance(0.f)
+        , MaxDrawDistance(0.f)
+        , bCastShadow(true)
+        , bCastDynamicShadow(true)
+        , ForcedLodModel(0)
+        , MinLOD(0)
+        , DetailMode(DM_Low)
+    {
+    }
+};
+
 USTRUCT(BlueprintType)
 struct FFlexRotationInfo
 {
@@ -286,6 +423,415 @@ struct FFlexUpVectorInfo
     }
 };
 
+USTRUCT(BlueprintType)
+struct FFlexMergeInfo
+{
+    GENERATED_BODY()
+
+    /**
+    * Static meshes baked from this layer in the editor. If set, they replace all other meshes of this layer,
+    * each rendered by a single component. Clear them to return to individual meshes
+    */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    TArray<UStaticMesh*> MergedMeshes;
+
+    /** Baking splits the layer into cubic chunks of this size, each becoming a separate mesh. 0 bakes a single mesh */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0.0", UIMax = "50000.0"))
+    float ChunkSize;
+
+    FFlexMergeInfo()
+        : ChunkSize(0.f)
+    {
+    }
+};
+
+USTRUCT(BlueprintType)
+struct FFlexSegmentationInfo
+{
+    GENERATED_BODY()
+
+    /**
+    * Resample spline meshes by curvature and length instead of placing one per spline point.
+    * Straight runs collapse into few meshes, bends are subdivided. Only relevant for spline meshes
+    */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    uint32 bAdaptive : 1;
+
+    /** Maximum distance between the spline and the spline meshes following it */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0.01", UIMax = "50.0", EditCondition = "bAdaptive"))
+    float Tolerance;
+
+    /** Maximum angle in degrees a single spline mesh may bend, before it is subdivided */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "1.0", ClampMax = "180.0", EditCondition = "bAdaptive"))
+    float MaxBendAngle;
+
+    /** Maximum length of a single spline mesh. 0 for no limit */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0.0", UIMax = "10000.0", EditCondition = "bAdaptive"))
+    float MaxSegmentLength;
+
+    /** Spline meshes are not subdivided below this length, regardless of tolerance and bend */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (ClampMin = "0.0", UIMax = "500.0", EditCondition = "bAdaptive"))
+    float MinSegmentLength;
+
+    FFlexSegmentationInfo()
+        : bAdaptive(false)
+        , Tolerance(2.f)
+        , MaxBendAngle(30.f)
+        , MaxSegmentLength(0.f)
+        , MinSegmentLength(10.f)
+    {
+    }
+};
+
+/**
+* Curves driving point parameters along the whole spline. Values are added to those of each spline point,
+* so point data only needs to store deviations from the curves
+*/
+USTRUCT(BlueprintType)
+struct FFlexCurveInfo
+{
+    GENERATED_BODY()
+
+    /** What the time axis of all curves is measured in */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    EFlexCurveDomain Domain;
+
+    /** Spline meshes: roll in degrees */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    class UCurveFloat* Roll;
+
+    /** Spline meshes: scale from X and Y, in place of the default scale of 1 */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    class UCurveVector* Scale;
+
+    /** Spline meshes: offset from X and Y */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    class UCurveVector* Offset;
+
+    /** Spline meshes: up direction */
+    UPROPERTY(EditAnywhere, Category = FlexSpline)
+    class UCurveVector* UpDirection;
+
+    /** Static meshes: location offset */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "SM Location Offset"))
+    class UCurveVector* SMLocationOffset;
+
+    /** Static meshes: scale offset */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "SM Scale"))
+    class UCurveVector* SMScale;
+
+    /** Static meshes: rotation with roll from X, pitch from Y and yaw from Z */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "SM Rotation"))
+    class UCurveVector* SMRotation;
+
+    FFlexCurveInfo()
+        : Domain(EFlexCurveDomain::Distance)
+        , Roll(nullptr)
+        , Scale(nullptr)
+        , Offset(nullptr)
+        , UpDirection(nullptr)
+        , SMLocationOffset(nullptr)
+        , SMScale(nullptr)
+        , SMRotation(nullptr)
+    {
+    }
+
+    bool HasCurves() const { return Roll || Scale || Offset || UpDirection || SMLocationOffset || SMScale || SMRotation; }
+};
+
+
+/**
+* Spline evaluated at a single spline point. Built once per rebuild for all points and shared by every layer
+*/
+struct FFlexSplineFrame
+{
+    /** Local location of the spline point */
+    FVector Location;
+
+    /** Local tangent of the spline point */
+    FVector Tangent;
+
+    /** Normalized tangent */
+    FVector Direction;
+
+    /** Local rotation of the spline point */
+    FRotator Rotation;
+
+    /** Scale of the spline point */
+    FVector Scale;
+
+    /** Coordinate system for locations local to this spline point, derived from its direction */
+    FRotator DirectionRotation;
+
+    /** Coordinate system for up directions local to this spline point, averaged over both neighbours' directions */
+    FRotator UpRotation;
+};
+
+/**
+* Arc length of the spline, sampled evenly by spline input key. Built once per rebuild if any layer places
+* its meshes by distance. Covers every segment including the one closing the loop, like spline meshes do
+*/
+struct FFlexArcLengthTable
+{
+    /** Spline input key of each sample, ascending */
+    TArray<float> Keys;
+
+    /** Distance along the spline of each sample, ascending */
+    TArray<float> Distances;
+
+    /** Length of the spline up to input key @param Key */
+    float GetDistanceAtKey(float Key) const;
+
+    /** Spline input key at @param Distance along the spline, linearly interpolated between samples */
+    float GetKeyAtDistance(float Distance) const;
+
+    void Reset()
+    {
+        Keys.Reset();
+        Distances.Reset();
+    }
+};
+
+/**
+* Maps spline points onto point data of the last rebuild
+*/
+struct FFlexPointDiff
+{
+    /** For each spline point, index of the point data it keeps, or INDEX_NONE if the point was inserted */
+    TArray<int32> SourceIndices;
+
+    /** Indices of point data without spline point, in ascending order */
+    TArray<int32> DeletedIndices;
+
+    /** Number of points that kept their data, but not their location */
+    int32 NumMoved;
+
+    /** Number of points without data */
+    int32 NumInserted;
+
+    FFlexPointDiff()
+        : NumMoved(0)
+        , NumInserted(0)
+    {
+    }
+
+    bool HasInsertionsOrDeletions() const { return (NumInserted > 0) || (DeletedIndices.Num() > 0); }
+};
+
+/**
+* Mesh update of a single segment, waiting for time-sliced construction
+*/
+struct FFlexPendingSegment
+{
+    /** Identifier of the layer. Layers are looked up when processed, the layer maps may have changed since queuing */
+    int32 LayerID;
+
+    /** Spline point index, or INDEX_NONE to update an instanced, adaptive or distributed layer as a whole */
+    int32 Index;
+
+    /** Squared distance to the closest viewer when queued, lower values are processed first */
+    float Priority;
+
+    FFlexPendingSegment(int32 InLayerID, int32 InIndex, float InPriority)
+        : LayerID(InLayerID)
+        , Index(InIndex)
+        , Priority(InPriority)
+    {
+    }
+};
+
+/**
+* Wall time in seconds of each phase of the last construction, along with what it has done
+*/
+struct FFlexConstructionTimings
+{
+    /** InitializeNewMeshData and GatherLayers */
+    double GatherLayers;
+
+    /** UpdateSplineFrames and UpdateArcLengthTable */
+    double SplineFrames;
+
+    /** DiffSplinePoints, ApplyPointDiff and UpdatePointData */
+    double PointDiff;
+
+    /** GatherDirtySegments */
+    double DirtyTracking;
+
+    /** ResolveSegments */
+    double ResolveSegments;
+
+    /** PrepareMeshComponents */
+    double PrepareComponents;
+
+    /** UpdateMeshComponents, or all ProcessPendingSegments calls of a time-sliced construction */
+    double UpdateComponents;
+
+    int32 NumSplinePoints;
+    int32 NumPointOverrides;
+    int32 NumLayers;
+    int32 NumDirtySegments;
+    int32 NumUpdatedSegments;
+    int32 NumCreatedComponents;
+    int32 NumReusedComponents;
+
+    FFlexConstructionTimings()
+        : GatherLayers(0.0)
+        , SplineFrames(0.0)
+        , PointDiff(0.0)
+        , DirtyTracking(0.0)
+        , ResolveSegments(0.0)
+        , PrepareComponents(0.0)
+        , UpdateComponents(0.0)
+        , NumSplinePoints(0)
+        , NumPointOverrides(0)
+        , NumLayers(0)
+        , NumDirtySegments(0)
+        , NumUpdatedSegments(0)
+        , NumCreatedComponents(0)
+        , NumReusedComponents(0)
+    {
+    }
+
+    double GetTotal() const
+    {
+        return GatherLayers + SplineFrames + PointDiff + DirtyTracking + ResolveSegments + PrepareComponents + UpdateComponents;
+    }
+};
+
+/**
+* Seeded random offsets of a single layer at a single spline point
+*/
+struct FFlexRandomOffsets
+{
+    FVector Location;
+    FRotator Rotation;
+    FVector Scale;
+
+    /** Uniform random value in [0, 1), compared against the layer's spawn chance */
+    float SpawnRoll;
+};
+
+/**
+* Parameter curves of a layer, sampled at a series of input keys. All values are offsets added to point data,
+* channels without a curve stay empty and read as zero
+*/
+struct FFlexCurveSamples
+{
+    TArray<float> Rolls;
+    TArray<FVector2D> Scales;
+    TArray<FVector2D> Offsets;
+    TArray<FVector> UpDirections;
+    TArray<FVector> SMLocationOffsets;
+    TArray<FVector> SMScales;
+    TArray<FRotator> SMRotations;
+
+    float GetRoll(int32 Index) const                { return Rolls.IsValidIndex(Index) ? Rolls[Index] : 0.f; }
+    FVector2D GetScale(int32 Index) const           { return Scales.IsValidIndex(Index) ? Scales[Index] : FVector2D::ZeroVector; }
+    FVector2D GetOffset(int32 Index) const          { return Offsets.IsValidIndex(Index) ? Offsets[Index] : FVector2D::ZeroVector; }
+    FVector GetUpDirection(int32 Index) const       { return UpDirections.IsValidIndex(Index) ? UpDirections[Index] : FVector::ZeroVector; }
+    FVector GetSMLocationOffset(int32 Index) const  { return SMLocationOffsets.IsValidIndex(Index) ? SMLocationOffsets[Index] : FVector::ZeroVector; }
+    FVector GetSMScale(int32 Index) const           { return SMScales.IsValidIndex(Index) ? SMScales[Index] : FVector::ZeroVector; }
+    FRotator GetSMRotation(int32 Index) const       { return SMRotations.IsValidIndex(Index) ? SMRotations[Index] : FRotator::ZeroRotator; }
+
+    void Reset()
+    {
+        Rolls.Reset();
+        Scales.Reset();
+        Offsets.Reset();
+        UpDirections.Reset();
+        SMLocationOffsets.Reset();
+        SMScales.Reset();
+        SMRotations.Reset();
+    }
+
+    SIZE_T GetAllocatedSize() const
+    {
+        return Rolls.GetAllocatedSize() + Scales.GetAllocatedSize() + Offsets.GetAllocatedSize() + UpDirections.GetAllocatedSize()
+            + SMLocationOffsets.GetAllocatedSize() + SMScales.GetAllocatedSize() + SMRotations.GetAllocatedSize();
+    }
+};
+
+
+/**
+* Placement of a single mesh or instance, resolved from spline, point and layer data.
+* Filled by the side-effect free compute phase of the construction, then pushed to components on the game thread
+*/
+USTRUCT()
+struct FFlexResolvedSegment
+{
+    GENERATED_BODY()
+
+    /** Should a mesh be rendered for this segment at all? */
+    UPROPERTY()
+    uint32 bVisible : 1;
+
+    /** Relative location of the mesh */
+    UPROPERTY()
+    FVector Location;
+
+    /** Relative rotation of the mesh */
+    UPROPERTY()
+    FRotator Rotation;
+
+    /** Relative scale of the mesh. Spline meshes only use X, their Y and Z scale is applied via start and end scale */
+    UPROPERTY()
+    FVector Scale;
+
+// ============================= SPLINE MESH FEATURES
+
+    UPROPERTY()
+    FVector StartLocation;
+
+    UPROPERTY()
+    FVector StartTangent;
+
+    UPROPERTY()
+    FVector EndLocation;
+
+    UPROPERTY()
+    FVector EndTangent;
+
+    UPROPERTY()
+    FVector UpDirection;
+
+    UPROPERTY()
+    float StartRoll;
+
+    UPROPERTY()
+    float EndRoll;
+
+    UPROPERTY()
+    FVector2D StartScale;
+
+    UPROPERTY()
+    FVector2D EndScale;
+
+    UPROPERTY()
+    FVector2D StartOffset;
+
+    UPROPERTY()
+    FVector2D EndOffset;
+
+    FFlexResolvedSegment()
+        : bVisible(false)
+        , Location(0.f)
+        , Rotation(0.f)
+        , Scale(1.f)
+        , StartLocation(0.f)
+        , StartTangent(0.f)
+        , EndLocation(0.f)
+        , EndTangent(0.f)
+        , UpDirection(0.f, 0.f, 1.f)
+        , StartRoll(0.f)
+        , EndRoll(0.f)
+        , StartScale(1.f, 1.f)
+        , EndScale(1.f, 1.f)
+        , StartOffset(0.f, 0.f)
+        , EndOffset(0.f, 0.f)
+    {
+    }
+};
+
 
 /**
 * Stores info on what meshes and which default values on each spline point are initialized
@@ -308,10 +854,18 @@ struct FSplineMeshInitData
     UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Rendering"))
     FFlexRenderInfo RenderInfo;
 
+    /** Placement along the spline */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Placement"))
+    FFlexPlacementInfo PlacementInfo;
+
     /** Configuration of physics and collision */
     UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Physics"))
     FFlexPhysicsInfo PhysicsInfo;
 
+    /** Draw distance, shadow and LOD settings, applied to all components or instances of this layer */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Render Cost"))
+    FFlexRenderCostInfo RenderCostInfo;
+
     /** Rotation control relative to spline point */
     UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Rotation"))
     FFlexRotationInfo RotationInfo;
@@ -328,24 +882,100 @@ struct FSplineMeshInitData
     UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Up Vector"))
     FFlexUpVectorInfo UpVectorInfo;
 
+    /** Curvature adaptive resampling of spline meshes */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Segmentation"))
+    FFlexSegmentationInfo SegmentationInfo;
+
+    /** Baking spline meshes into merged static meshes */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Merging"))
+    FFlexMergeInfo MergeInfo;
+
+    /** Parameters driven along the spline. Each curve replaces the Flex Spline's curve of the same parameter */
+    UPROPERTY(EditAnywhere, Category = FlexSpline, meta = (DisplayName = "Curves"))
+    FFlexCurveInfo CurveInfo;
+
+
+    /** Stable identifier, assigned once by the owning Flex Spline. Unaffected by renaming or reordering layers */
+    UPROPERTY()
+    int32 LayerID;
+
+    /** Key of this layer in the owning Flex Spline's layer map, cached at the start of each rebuild */
+    FName LayerName;
+
+    /** Seed for random values of this layer, derived from the actor seed and layer identifier at the start of each rebuild */
+    uint32 LayerSeed;
+
+    /**
+    * Stores all spline mesh components, driven by data from this instance.
+    * Only spline points that render a mesh own one, associated via the point identifier
+    */
+    TMap<int32, WeakStaticMeshComp> MeshComponents;
+
+    /** Spline meshes of an adaptive layer, one per resampled segment. MeshComponents is empty then */
+    TArray<WeakStaticMeshComp> AdaptiveMeshComponents;
 
     /**
-    * Stores all spline mesh components, driven by data from this instance
-    * Each mesh is associated to a spline point via its index
+    * Renders all static meshes of this layer if instancing is enabled.
+    * MeshComponents is empty then
     */
-    TArray<WeakStaticMeshComp> MeshComponentsArray;
+    WeakInstancedComp InstancedMeshComponent;
 
-    /** Shows the spline up vector at each spline point */
-    TArray<WeakArrowComp> ArrowSplineUpIndicatorArray;
+    /** Static meshes of a layer placed by distance, one per distributed segment. MeshComponents is empty then */
+    TArray<WeakStaticMeshComp> DistributedMeshComponents;
+
+    /** Renders the merged meshes of this layer, one component per mesh. All other components are released then */
+    TArray<WeakStaticMeshComp> MergedMeshComponents;
+
+    /** Resolved placement for each spline point. Entries of clean segments are kept from earlier rebuilds */
+    TArray<FFlexResolvedSegment> ResolvedSegments;
+
+    /** Adaptive layers only: visible resolved segments, resampled by curvature and length */
+    TArray<FFlexResolvedSegment> AdaptiveSegments;
+
+    /** Layers placed by distance only: placement of every visible mesh along the spline */
+    TArray<FFlexResolvedSegment> DistributedSegments;
+
+    /** Spline points selected by activity, looping, render mode and accumulated spawn chance */
+    TBitArray<> RenderRuleMask;
+
+    /** Spline points that render a mesh: the render rule mask, filtered by random spawn chance */
+    TBitArray<> VisibilityMask;
+
+    /** Hash of all settings RenderRuleMask was compiled from, including the number of spline points */
+    uint32 RenderRuleHash;
+
+    /** Random values for each spline point. Only regenerated for dirty segments, or all of them if settings change */
+    TArray<FFlexRandomOffsets> RandomOffsets;
+
+    /** Curves of this layer and the Flex Spline, sampled at every spline point including the end of a closed loop */
+    FFlexCurveSamples CurveSamples;
+
+    /** Hash of all mesh relevant settings of this layer at the time of the last rebuild */
+    uint32 LastBuildHash;
+
+    /** Have mesh relevant settings changed since the last rebuild? If so, all meshes of this layer are updated */
+    bool bSettingsDirty;
+
+    /** Segments whose mesh update is still waiting for time-sliced construction */
+    TBitArray<> PendingSegments;
+
+    /** Are the instances, adaptive or distributed segments of this layer waiting for time-sliced construction? */
+    bool bLayerPending;
 
 
     FSplineMeshInitData()
-        : bTemplatedInitialized(false)
+        : LayerID(INDEX_NONE)
+        , LayerSeed(0)
+        , RenderRuleHash(0)
+        , LastBuildHash(0)
+        , bSettingsDirty(true)
+        , bLayerPending(false)
+        , bTemplatedInitialized(false)
     {
         SET_BIT(GeneralInfo, EFlexGeneralFlags::Active);
     }
 
-    /** Delete all spline meshes and arrows on destruction */
+    /** Delete all meshes on destruction */
     ~FSplineMeshInitData();
 
     bool operator==(const FSplineMeshInitData& Other) const
@@ -354,8 +984,15 @@ struct FSplineMeshInitData
     }
 
     bool IsInitialized() const { return bTemplatedInitialized; }
+    bool IsInstanced() const { return MeshInfo.bUseInstancing && MeshInfo.MeshType == EFlexSplineMeshType::StaticMesh; }
+    bool IsAdaptive() const { return SegmentationInfo.bAdaptive && MeshInfo.MeshType == EFlexSplineMeshType::SplineMesh; }
+    bool IsDistributed() const { return PlacementInfo.Mode == EFlexPlacementMode::Distance && MeshInfo.MeshType == EFlexSplineMeshType::StaticMesh; }
+    bool IsMerged() const { return MergeInfo.MergedMeshes.Num() > 0; }
     void Initialize() { bTemplatedInitialized = true; }
 
+    /** Take over all settings of @param Source, e.g. a preset layer. Components, identifiers and resolved state are kept */
+    void CopySettings(const FSplineMeshInitData& Source);
+
 
 private:
 
@@ -366,7 +1003,8 @@ private:
 
 
 /**
-* Stores data for each spline point, may override initial data
+* Data of a single spline point, may override initial data. Flex Splines store it in FFlexPointDataChannels,
+* this struct passes single points around and loads saves from before the channels existed
 */
 USTRUCT(BlueprintType)
 struct FSplinePointData
@@ -420,12 +1058,17 @@ struct FSplinePointData
     FRotator SMRotation;
 
 
-    /** Displays the index for the associated spline point */
+    /** Point numbers are drawn by the editor visualizer now, kept to destroy components of old saves */
     UPROPERTY()
-    class UTextRenderComponent* IndexTextRenderer;
+    class UTextRenderComponent* IndexTextRenderer_DEPRECATED;
 
-    /** Unique identifier, hash-value */
-    uint32 ID;
+    /** Persistent identifier, assigned once by the owning Flex Spline */
+    UPROPERTY()
+    int32 PointID;
+
+    /** Local location of the associated spline point at the last rebuild, used to match points after edits */
+    UPROPERTY()
+    FVector LastLocation;
 
     /** CONSTRUCTOR */
     FSplinePointData()
@@ -440,12 +1083,255 @@ struct FSplinePointData
         , SMLocationOffset(0.f)
         , SMScale(0.f)
         , SMRotation(0.f)
-        , IndexTextRenderer(nullptr)
-        , ID(0)
+        , IndexTextRenderer_DEPRECATED(nullptr)
+        , PointID(INDEX_NONE)
+        , LastLocation(0.f)
         {
         }
 };
 
+/** Flags of a single spline point */
+UENUM(meta = (Bitflags))
+enum class EFlexPointFlags : uint8
+{
+    /** Deform start values to match the previous point's end values, see FSplinePointData::bSynchroniseWithPrevious */
+      SynchroniseWithPrevious
+};
+
+/**
+* Presence bits of a point data channel with one bit per spline point. A set bit means the point overrides the
+* channel's default and has a value in the packed values. Ranks make finding that value O(1)
+*/
+USTRUCT()
+struct FFlexOverrideMask
+{
+    GENERATED_BODY()
+
+    /** Bit Index % 32 of word Index / 32 belongs to point Index */
+    UPROPERTY()
+    TArray<uint32> Words;
+
+    /** Set bits in all words before each word, not serialized but rebuilt on loading */
+    TArray<int32> Ranks;
+
+    static FORCEINLINE int32 CountBits(uint32 Bits)
+    {
+        Bits = Bits - ((Bits >> 1) & 0x55555555);
+        Bits = (Bits & 0x33333333) + ((Bits >> 2) & 0x33333333);
+        return static_cast<int32>((((Bits + (Bits >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24);
+    }
+
+    bool IsSet(int32 Index) const { return (Words[Index >> 5] & (1u << (Index & 31))) != 0; }
+
+    /** @return Position of point @param Index in the packed values, INDEX_NONE if it keeps the default */
+    FORCEINLINE int32 GetPackedIndex(int32 Index) const
+    {
+        const int32 word  = Index >> 5;
+        const uint32 bit  = 1u << (Index & 31);
+        return (Words[word] & bit) ? Ranks[word] + CountBits(Words[word] & (bit - 1)) : INDEX_NONE;
+    }
+
+    /** @return Number of points overriding the default */
+    int32 NumSet() const { return (Words.Num() > 0) ? Ranks.Last() + CountBits(Words.Last()) : 0; }
+
+    /** Resize to @param NumPoints, bits of new points and of those beyond the end are cleared */
+    void SetNum(int32 NumPoints);
+
+    void Set(int32 Index);
+    void Clear(int32 Index);
+
+    void RebuildRanks();
+
+    bool Serialize(FArchive& Ar);
+};
+
+template<>
+struct TStructOpsTypeTraits<FFlexOverrideMask> : public TStructOpsTypeTraitsBase2<FFlexOverrideMask>
+{
+    enum
+    {
+        WithSerializer = true,
+    };
+};
+
+/** @return Value of point @param Index of a masked channel, @param Default if the point does not override it */
+template <typename T>
+FORCEINLINE T GetPointOverride(const FFlexOverrideMask& Mask, const TArray<T>& Values, int32 Index, const T& Default)
+{
+    const int32 packedIndex = Mask.GetPackedIndex(Index);
+    return (packedIndex != INDEX_NONE) ? Values[packedIndex] : Default;
+}
+
+/**
+* Data of all spline points, stored as one contiguous array per channel. Passes reading a single field stream
+* through it instead of striding across whole points.
+* Most points keep the defaults of FSplinePointData, so override channels only store the values of points that
+* differ, packed in point order behind a FFlexOverrideMask. Flags, identifiers and locations are stored for every point
+*/
+USTRUCT()
+struct FFlexPointDataChannels
+{
+    GENERATED_BODY()
+
+    UPROPERTY()
+    FFlexOverrideMask StartRollMask;
+
+    UPROPERTY()
+    TArray<float> StartRolls;
+
+    UPROPERTY()
+    FFlexOverrideMask EndRollMask;
+
+    UPROPERTY()
+    TArray<float> EndRolls;
+
+    UPROPERTY()
+    FFlexOverrideMask StartScaleMask;
+
+    UPROPERTY()
+    TArray<FVector2D> StartScales;
+
+    UPROPERTY()
+    FFlexOverrideMask EndScaleMask;
+
+    UPROPERTY()
+    TArray<FVector2D> EndScales;
+
+    UPROPERTY()
+    FFlexOverrideMask StartOffsetMask;
+
+    UPROPERTY()
+    TArray<FVector2D> StartOffsets;
+
+    UPROPERTY()
+    FFlexOverrideMask EndOffsetMask;
+
+    UPROPERTY()
+    TArray<FVector2D> EndOffsets;
+
+    UPROPERTY()
+    FFlexOverrideMask UpDirectionMask;
+
+    UPROPERTY()
+    TArray<FVector> UpDirections;
+
+    UPROPERTY()
+    FFlexOverrideMask SMLocationOffsetMask;
+
+    UPROPERTY()
+    TArray<FVector> SMLocationOffsets;
+
+    UPROPERTY()
+    FFlexOverrideMask SMScaleMask;
+
+    UPROPERTY()
+    TArray<FVector> SMScales;
+
+    UPROPERTY()
+    FFlexOverrideMask SMRotationMask;
+
+    UPROPERTY()
+    TArray<FRotator> SMRotations;
+
+    /** Bitmask of EFlexPointFlags */
+    UPROPERTY()
+    TArray<uint8> Flags;
+
+    /** Persistent identifiers, assigned once by the owning Flex Spline */
+    UPROPERTY()
+    TArray<int32> PointIDs;
+
+    /** Local locations of the associated spline points at the last rebuild, used to match points after edits */
+    UPROPERTY()
+    TArray<FVector> LastLocations;
+
+    int32 Num() const { return PointIDs.Num(); }
+    bool IsValidIndex(int32 Index) const { return PointIDs.IsValidIndex(Index); }
+
+    // Override channels, defaults match those of FSplinePointData
+    float GetStartRoll(int32 Index) const               { return GetPointOverride(StartRollMask, StartRolls, Index, 0.f); }
+    float GetEndRoll(int32 Index) const                 { return GetPointOverride(EndRollMask, EndRolls, Index, 0.f); }
+    FVector2D GetStartScale(int32 Index) const          { return GetPointOverride(StartScaleMask, StartScales, Index, FVector2D(1.f, 1.f)); }
+    FVector2D GetEndScale(int32 Index) const            { return GetPointOverride(EndScaleMask, EndScales, Index, FVector2D(1.f, 1.f)); }
+    FVector2D GetStartOffset(int32 Index) const         { return GetPointOverride(StartOffsetMask, StartOffsets, Index, FVector2D::ZeroVector); }
+    FVector2D GetEndOffset(int32 Index) const           { return GetPointOverride(EndOffsetMask, EndOffsets, Index, FVector2D::ZeroVector); }
+    FVector GetUpDirection(int32 Index) const           { return GetPointOverride(UpDirectionMask, UpDirections, Index, FVector::ZeroVector); }
+    FVector GetSMLocationOffset(int32 Index) const      { return GetPointOverride(SMLocationOffsetMask, SMLocationOffsets, Index, FVector::ZeroVector); }
+    FVector GetSMScale(int32 Index) const               { return GetPointOverride(SMScaleMask, SMScales, Index, FVector::ZeroVector); }
+    FRotator GetSMRotation(int32 Index) const           { return GetPointOverride(SMRotationMask, SMRotations, Index, FRotator::ZeroRotator); }
+
+    /** Setting a default value removes the point's override */
+    void SetStartRoll(int32 Index, float Value);
+    void SetEndRoll(int32 Index, float Value);
+    void SetStartScale(int32 Index, const FVector2D& Value);
+    void SetEndScale(int32 Index, const FVector2D& Value);
+    void SetStartOffset(int32 Index, const FVector2D& Value);
+    void SetEndOffset(int32 Index, const FVector2D& Value);
+    void SetUpDirection(int32 Index, const FVector& Value);
+    void SetSMLocationOffset(int32 Index, const FVector& Value);
+    void SetSMScale(int32 Index, const FVector& Value);
+    void SetSMRotation(int32 Index, const FRotator& Value);
+
+    bool GetSynchroniseWithPrevious(int32 Index) const { return TEST_BIT(Flags[Index], EFlexPointFlags::SynchroniseWithPrevious); }
+    void SetSynchroniseWithPrevious(int32 Index, bool bSynchronise);
+
+    /** Resize all channels, new points receive default values */
+    void SetNum(int32 NewNum);
+
+    /** Reorder all channels in a single pass. Point i is taken from @param SourceIndices[i], or defaulted if INDEX_NONE */
+    void Remap(const TArray<int32>& SourceIndices);
+
+    /** Copy of all channels of a single point, e.g. for the details panel */
+    FSplinePointData GetPoint(int32 Index) const;
+    void SetPoint(int32 Index, const FSplinePointData& Point);
+
+    /**
+    * Bring all channels to the length of the longest per-point one and drop override channels whose values do not
+    * match their mask, e.g. after loading data of mismatching versions. Override channels saved with one value per
+    * point are compacted
+    */
+    void FixupChannels();
+
+    /** @return Number of overridden values over all override channels */
+    int32 GetNumOverrides() const;
+
+    SIZE_T GetAllocatedSize() const;
+};
+
+
+
+/**
+* Unregistered components of a single class, kept by the Flex Spline for reuse
+*/
+USTRUCT()
+struct FFlexComponentPoolBucket
+{
+    GENERATED_BODY()
+
+    UPROPERTY(Transient)
+    TArray<USceneComponent*> Components;
+};
+
+
+
+/**
+* Layout of a single layer baked when cooking. Cooked builds spawn meshes from it instead of evaluating the spline.
+* Kept by the Flex Spline rather than the layer, so layer templates and presets never carry it
+*/
+USTRUCT()
+struct FFlexBakedLayer
+{
+    GENERATED_BODY()
+
+    /** Resolved placement of every visible (adaptive or distributed) segment */
+    UPROPERTY()
+    TArray<FFlexResolvedSegment> Segments;
+
+    /** Point identifier for each baked segment, so cooked components can still be updated by a rebuild */
+    UPROPERTY()
+    TArray<int32> PointIDs;
+};
+
 
 
 /**
@@ -463,62 +1349,218 @@ public:
     AFlexSplineActor();
     void OnConstruction(const FTransform& Transform) override;
     void PreInitializeComponents() override;
+    void PostLoad() override;
+    void BeginDestroy() override;
+#if WITH_EDITOR
+    void PreSave(const class ITargetPlatform* TargetPlatform) override;
+#endif
 
     int32 GetMeshCountForType(EFlexSplineMeshType MeshType) const;
 
+    /** Spline the meshes are placed along */
+    class USplineComponent* GetSplineComponent() const { return SplineComponent; }
+
+    /** Shared layers this Flex Spline builds besides its own, if any */
+    class UFlexSplineLayerPreset* GetLayerPreset() const { return LayerPreset; }
+
+    /** Call @param Function for all own layers, then all instanced preset layers. Unlike Layers also valid between rebuilds */
+    template <typename TFunction>
+    void ForEachLayer(TFunction Function) const
+    {
+        for (const auto& meshInitDataPair : MeshDataInitMap)
+        {
+            Function(meshInitDataPair.Value);
+        }
+        for (const auto& presetLayerPair : PresetLayers)
+        {
+            Function(presetLayerPair.Value);
+        }
+    }
+
+    /** Phase timings of the last construction, ResolveLayout resets them */
+    const FFlexConstructionTimings& GetLastConstructionTimings() const { return LastConstructionTimings; }
+
+    /** Rebuild all meshes, e.g. after changing the spline at runtime. See OnConstructionCompleted */
+    UFUNCTION(BlueprintCallable, Category = "FlexSpline")
+    void Rebuild();
+
+    /** Are meshes of the last rebuild still waiting for time-sliced construction? */
+    UFUNCTION(BlueprintCallable, Category = "FlexSpline")
+    bool IsConstructionPending() const;
+
+    /**
+    * Called by the construction manager. Push pending segments to components, nearest to the viewer first,
+    * until @param EndTime has passed. Returns true once all of them are done
+    */
+    bool ProcessPendingSegments(double EndTime);
+
+    /**
+    * Editing paths report each spline point they insert at or remove from @param Index, so point data follows its
+    * spline point by identifier. Unreported changes fall back to matching by location, see DiffSplinePoints
+    */
+    void NotifySplinePointInserted(int32 Index);
+    void NotifySplinePointRemoved(int32 Index);
+
+
+public:
+
+    /** Broadcast once all meshes of a rebuild exist. Delayed by time-sliced construction */
+    UPROPERTY(BlueprintAssignable, Category = "FlexSpline")
+    FFlexSplineConstructionCompleted OnConstructionCompleted;
+
 
 protected:
 
     /** Spawns and initiates spline mesh components for each spline point */
     void ConstructSplineMesh();
 
+    /**
+    * Bring all layers' ResolvedSegments up to date without touching any components, marking every
+    * segment that has changed since the last rebuild in @param OutDirtySegments
+    */
+    void ResolveLayout(TBitArray<>& OutDirtySegments);
+
+    /** Cooked builds: spawn meshes and instances from the layout baked during cooking, in a single pass */
+    void ApplyBakedLayout();
+
+#if WITH_EDITOR
+    /** Placement of the visible segments of @param MeshInitData, and for per point layers their point identifiers */
+    void BakeLayout(const FSplineMeshInitData& MeshInitData, FFlexBakedLayer& OutBakedLayer) const;
+
+    /** Drop the layout baked for cooking once @param Package, the one containing this Flex Spline, is saved */
+    void OnPackageSaved(const FString& PackageFileName, UObject* Package);
+#endif
+
+    /** Should meshes be built over several frames instead of at once? Only runtime rebuilds are time-sliced */
+    bool ShouldTimeSliceConstruction() const;
+
+    /**
+    * Instead of updating components, mark all dirty segments of all layers as pending and hand the Flex Spline
+    * to the construction manager. Pending segments are ordered by distance to the viewers of the last frame
+    */
+    void QueuePendingSegments(const TBitArray<>& DirtySegments);
+
     /** If mesh data has just been created initialize it with template */
     void InitializeNewMeshData();
 
-    /** Create new point data if theres a new spline point */
-    void AddPointDataEntries();
+    /**
+    * Instance preset layers that are not overridden by an own layer of the same name, assign missing layer identifiers
+    * and gather all layers into Layers, caching their names and seeds
+    */
+    void GatherLayers();
+
+    /** Evaluate the spline once at every spline point and store the results in SplineFrames */
+    void UpdateSplineFrames();
 
-    /** Remove point data associated with deleted spline point */
-    void RemovePointDataEntries(const TArray<int32>& DeletedIndices);
+    /** Sample the arc length of all segments into ArcLengthTable, if any layer places its meshes or samples curves by distance */
+    void UpdateArcLengthTable();
 
-    /** Create new mesh components if there are fewer meshes than spline points */
-    void InitDataAddMeshes();
+    /**
+    * Match spline points against point data in linear time. Uses SplinePointIDs while they match the spline,
+    * otherwise falls back to the last known locations: points that kept their location anchor the match,
+    * points and data in between are paired in order
+    */
+    void DiffSplinePoints(FFlexPointDiff& OutDiff) const;
 
-    /** Remove mesh components if there are more meshes than spline points */
-    void InitDataRemoveMeshes(const TArray<int32>& DeletedIndices);
+    /** Compact point data according to @param Diff. Releases components of deleted points */
+    void ApplyPointDiff(const FFlexPointDiff& Diff);
 
-    /** Bring point data identifiers up to date */
+    /** Assign identifiers to new point data and remember spline point identifiers and locations for the next rebuild */
     void UpdatePointData();
 
-    /** Adjust text renderer position and text according to points and meshes */
-    void UpdateDebugInformation();
+    /**
+    * Compare spline points, point data, mesh layers and global settings against the last rebuild.
+    * Marks every segment touched by a changed point (including its neighbours) in @param OutDirtySegments
+    * and flags layers with changed settings
+    */
+    void GatherDirtySegments(TBitArray<>& OutDirtySegments);
+
+
+    /** Game thread: switch dirty layers between instances and per point components */
+    void PrepareMeshComponents();
 
+    /**
+    * Compute phase: resolve placement of all dirty segments of all layers into their ResolvedSegments buffer.
+    * Runs in parallel across layers x points and has no side effects besides writing each segment's own entry
+    */
+    void ResolveSegments(const TBitArray<>& DirtySegments);
 
-    /** Set mesh values according to mesh and point data */
-    void UpdateMeshComponents();
+    /**
+    * Evaluate all curves of @param MeshInitData and the Flex Spline at the input keys @param Keys into @param OutSamples,
+    * in one sweep over all keys per curve
+    */
+    void SampleCurves(const FSplineMeshInitData& MeshInitData, const TArray<float>& Keys, FFlexCurveSamples& OutSamples) const;
+
+    /** Called by ResolveSegments, specialized for spline meshes */
+    void ResolveSplineMesh(const FSplineMeshInitData& MeshInitData, int32 CurrentIndex, FFlexResolvedSegment& OutSegment) const;
+
+    /**
+    * Called by ResolveSegments for a batch of visible static meshes of one layer, at the spline points @param Indices.
+    * Transforms are composed by vectorized kernels, see FlexSplineBatchKernels
+    */
+    void ResolveStaticMeshes(FSplineMeshInitData& MeshInitData, const int32* Indices, int32 NumIndices) const;
+
+    /**
+    * Called by ResolveSegments for adaptive layers. Joins runs of visible, compatible resolved segments and splits them
+    * again wherever tolerance, bend angle or length are exceeded, preferring spline points as split positions
+    */
+    void ResolveAdaptiveSegments(FSplineMeshInitData& MeshInitData) const;
+
+    /**
+    * Called by ResolveSegments for layers placed by distance. Resolves a static mesh every "Spacing" units along the spline,
+    * with spline frame and point data interpolated and curves sampled at its input key, in parallel across meshes
+    */
+    void ResolveDistributedSegments(FSplineMeshInitData& MeshInitData) const;
+
+    /** Apply phase: push resolved segments to components, for dirty segments and dirty layers only */
+    void UpdateMeshComponents(const TBitArray<>& DirtySegments);
+
+    /**
+    * Called by UpdateMeshComponents for layers without instancing. Creates or replaces the mesh of a visible point,
+    * or releases the mesh of a hidden one. Returns true if the point renders a mesh
+    */
+    bool UpdateMeshComponent(FSplineMeshInitData& MeshInitData, int32 Index);
+
+    /**
+    * Apply mesh, material, collision and render cost settings of a layer to one of its components
+    * or its instanced component
+    */
+    void UpdateMeshSettings(const FSplineMeshInitData& MeshInitData, class UStaticMeshComponent* Mesh);
 
     /** Called by UpdateMeshComponents, specialized for spline meshes */
     void UpdateSplineMesh(const FSplineMeshInitData& MeshInitData, class USplineMeshComponent* SplineMesh,
-                          int32 CurrentIndex);
+                          const FFlexResolvedSegment& Segment);
 
     /** Called by UpdateMeshComponents, specialized for static meshes */
     void UpdateStaticMesh(const FSplineMeshInitData& MeshInitData, class UStaticMeshComponent* StaticMesh,
-                          int32 CurrentIndex);
+                          const FFlexResolvedSegment& Segment);
 
+    /** Called by UpdateMeshComponents for instanced layers. Rebuilds the instance buffer from all visible segments */
+    void UpdateInstancedMesh(FSplineMeshInitData& MeshInitData);
 
-protected:
+    /** Called by UpdateMeshComponents for adaptive layers. Updates one spline mesh per adaptive segment, returns their number */
+    int32 UpdateAdaptiveMeshes(FSplineMeshInitData& MeshInitData);
+
+    /** Called by UpdateMeshComponents for distributed layers without instancing. Updates one static mesh per distributed segment, returns their number */
+    int32 UpdateDistributedMeshes(FSplineMeshInitData& MeshInitData);
 
-    /** Return data's layer name, if available */
-    FName GetLayerName(const FSplineMeshInitData& MeshInitData) const;
+    /** Create, update or release the components rendering the merged meshes of @param MeshInitData */
+    void UpdateMergedMeshes(FSplineMeshInitData& MeshInitData);
 
-    /** Find and return all indices of spline mesh that were deleted since last update */
-    void GetDeletedIndices(TArray<int32>& OutIndexArray) const;
 
-    /** Find best position for the text renderer at this index */
+protected:
+
+    /** Report the memory of point and layer data to the stats system. Releases all of it if @param bDestroying */
+    void UpdateMemoryStats(bool bDestroying = false);
+
+    /** Find best position for the point number at this index, above all meshes of the last rebuild */
     FVector GetTextPosition(int32 Index) const;
 
-    /** Is rendering allowed, given the current index? */
-    bool CanRenderFromMode(const FSplineMeshInitData& MeshInitData, int32 CurrentIndex, int32 FinalIndex) const;
+    /**
+    * Recompile the render rules of @param MeshInitData if they or the number of points have changed,
+    * then apply random spawn chance to all points, or to dirty segments only if nothing else has changed
+    */
+    void UpdateVisibilityMask(FSplineMeshInitData& MeshInitData, const TBitArray<>& DirtySegments) const;
 
     /** Find appropriate collision taking Mesh Layer and Flex Spline config into account */
     ECollisionEnabled::Type GetCollisionEnabled(const FSplineMeshInitData& MeshInitData) const;
@@ -526,32 +1568,53 @@ protected:
     /** See if looping is enabled globally and for given mesh data */
     bool GetCanLoop(const FSplineMeshInitData& MeshInitData) const;
 
+    /** Own or instanced preset layer with identifier @param LayerID, if any. Unlike Layers also valid between rebuilds */
+    FSplineMeshInitData* FindLayer(int32 LayerID);
+
+    /** Does any curve of @param MeshInitData or the Flex Spline depend on the distance along the spline? */
+    bool GetUsesDistanceCurves(const FSplineMeshInitData& MeshInitData) const;
+
     /** Find out if current spline point should be synchronized */
-    bool GetCanSynchronize(const FSplinePointData& PointData) const;
+    bool GetCanSynchronize(int32 Index) const;
+
+    /** Evaluate the spline at input key @param Key between two spline points, the same way spline meshes follow it */
+    FFlexSplineFrame GetSplineFrameAtKey(float Key) const;
 
     /** Compute location for mesh according to spline, point and layer information, using the configured coordinate system */
-    FVector CalculateLocation(const FSplineMeshInitData& MeshInitData, const FSplinePointData& PointData, const int32 Index) const;
+    FVector CalculateLocation(const FSplineMeshInitData& MeshInitData, const FSplinePointData& Point,
+                              const FFlexSplineFrame& Frame, const FFlexRandomOffsets& Random) const;
 
     /** Compute rotation for mesh according to spline, point and layer information, using the configured coordinate system */
-    FRotator CalculateRotation(const FSplineMeshInitData& MeshInitData, const FSplinePointData& PointData, const int32 index) const;
+    FRotator CalculateRotation(const FSplineMeshInitData& MeshInitData, const FSplinePointData& Point,
+                               const FFlexSplineFrame& Frame, const FFlexRandomOffsets& Random) const;
 
     /** Compute scale for mesh according to spline, point and layer information*/
-    FVector CalculateScale(const FSplineMeshInitData& MeshInitData, const FSplinePointData& PointData, const int32 Index) const;
+    FVector CalculateScale(const FSplineMeshInitData& MeshInitData, const FSplinePointData& Point,
+                           const FFlexSplineFrame& Frame, const FFlexRandomOffsets& Random) const;
 
     /** Get up direction for spline according to chosen local space */
-    FVector CalculateUpDirection(const FSplineMeshInitData& MeshInitData, const FSplinePointData& PointData, const int32 Index) const;
+    FVector CalculateUpDirection(const FSplineMeshInitData& MeshInitData, const int32 Index) const;
 
-    /** Calculate location for spline mesh and apply to param outSplineMesh */
-    void SetSplineMeshLocation(const FSplineMeshInitData& MeshInitData, class USplineMeshComponent* outSplineMesh, int32 Index);
+    /** Calculate start, end and relative location for spline mesh and store them in @param OutSegment */
+    void ResolveSplineMeshLocation(const FSplineMeshInitData& MeshInitData, int32 Index, FFlexResolvedSegment& OutSegment) const;
+
+    /** Create a new mesh component of class @param MeshType, attached to the Actor root */
+    class UStaticMeshComponent* CreateMeshComponent(UClass* MeshType);
+
+    /** Create hierarchical instanced mesh component, add to Actor root, cache inside @param MeshInitData */
+    class UHierarchicalInstancedStaticMeshComponent* CreateInstancedMeshComponent(FSplineMeshInitData& MeshInitData);
+
+    /** Return the mesh component of the point @param PointID to the pool and remove its entry, if any */
+    void ReleaseMeshComponent(FSplineMeshInitData& MeshInitData, int32 PointID);
 
     /**
-    * Create a new mesh component of class meshType, add to mesh init data array.
-    * If no valid index is specified, it is appended
+    * Take a component of exactly @param ComponentClass from the pool, or create a new one if none is available.
+    * The result is registered and attached to the Actor root
     */
-    class UStaticMeshComponent* CreateMeshComponent(UClass* MeshType, FSplineMeshInitData& MeshInitData, int32 Index = -1);
+    USceneComponent* AcquireComponent(UClass* ComponentClass);
 
-    /** Create arrow component, add to Actor root, cache inside @param MeshInitData */
-    class UArrowComponent* CreateArrrowComponent(FSplineMeshInitData& MeshInitData);
+    /** Unregister @param Component and keep it for later reuse. Destroys it if the pool is full */
+    void ReleaseComponent(USceneComponent* Component);
 
 
 protected:
@@ -559,6 +1622,12 @@ protected:
     UPROPERTY(VisibleAnywhere, Category = "FlexSpline", meta = (AllowPrivateAccess = "true"))
     class USplineComponent* SplineComponent;
 
+#if WITH_EDITORONLY_DATA
+    /** Lets the editor draw point numbers and up directions, without any components per spline point */
+    UPROPERTY()
+    class UFlexSplineDebugComponent* DebugComponent;
+#endif
+
 
 protected:
 
@@ -579,20 +1648,36 @@ protected:
     UPROPERTY(EditAnywhere, Category = "FlexSpline|Global")
     EFlexGlobalConfigType Loop;
 
+    /** Seeds all random offsets and spawn chances. The same seed always results in the same placement */
+    UPROPERTY(EditAnywhere, Category = "FlexSpline|Global")
+    int32 RandomSeed;
+
+    /** Parameters driven along the spline for all layers, unless a layer has a curve of its own */
+    UPROPERTY(EditAnywhere, Category = "FlexSpline|Global", meta = (DisplayName = "Curves"))
+    FFlexCurveInfo CurveInfo;
+
+    /**
+    * Build meshes over several frames when constructed at runtime, nearest to the viewer first.
+    * The time per frame is set by flexspline.ConstructionBudgetMs
+    */
+    UPROPERTY(EditAnywhere, Category = "FlexSpline|Global")
+    bool bTimeSlicedConstruction;
+
     /** Blueprint for new "Mesh Layer" entries */
     UPROPERTY(EditAnywhere, Category = "FlexSpline|Global", meta = (DisplayName = "Mesh Layer Template"))
     FSplineMeshInitData MeshDataTemplate;
 
 
-    /** Should the index for each spline point be displayed? */
+#if WITH_EDITORONLY_DATA
+    /** Should the index for each spline point be displayed? Drawn while the Flex Spline is selected */
     UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "FlexSpline")
     bool bShowPointNumbers;
 
-    /** Spline index text renderer size */
+    /** Spline index text size in world units */
     UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "FlexSpline", meta = (ClampMin = "0.0", UIMax = "500.0"))
     float PointNumberSize;
 
-    /** Debug up direction arrow component size */
+    /** Debug up direction arrow size */
     UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "FlexSpline", meta = (ClampMin = "0.0", UIMax = "10.0"))
     float UpDirectionArrowSize;
 
@@ -600,27 +1685,122 @@ protected:
     UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "FlexSpline", meta = (ClampMin = "0.0", UIMax = "200.0"))
     float UpDirectionArrowOffset;
 
-    /** Color of the spline point text renderers */
+    /** Color of the spline point numbers */
     UPROPERTY(EditAnywhere, AdvancedDisplay, Category = "FlexSpline")
     FColor TextRenderColor;
+#endif
 
 
     /**
     * Mesh configuration for each spline point, resizes automatically
     */
     UPROPERTY()
+    FFlexPointDataChannels PointData;
+
+    /** Point data of saves from before the channels existed, moved into PointData on load */
+    UPROPERTY()
     TArray<FSplinePointData> PointDataArray;
 
+    /**
+    * Layers shared with other Flex Splines, built in addition to the own Mesh Layers. An own layer of the same name
+    * overrides the preset's layer, an inactive one disables it
+    */
+    UPROPERTY(EditAnywhere, Category = "FlexSpline", meta = (DisplayName = "Layer Preset"))
+    class UFlexSplineLayerPreset* LayerPreset;
+
     /** Stores all meshes(and related info) that should be spawned per spline point */
     UPROPERTY(EditAnywhere, Category = "FlexSpline", meta = (DisplayName = "Mesh Layers", NoElementDuplicate))
     TMap<FName, FSplineMeshInitData> MeshDataInitMap;
 
+    /** Instances of the preset's layers that are not overridden. Settings are copied from the preset on every rebuild, never saved */
+    UPROPERTY(Transient)
+    TMap<FName, FSplineMeshInitData> PresetLayers;
+
+    /** Unregistered components per class, recycled across rebuilds instead of being destroyed and created again */
+    UPROPERTY(Transient)
+    TMap<UClass*, FFlexComponentPoolBucket> ComponentPool;
+
 
 private:
 
     /** Cache lastly generated MeshDataInitMap key to circumvent strange engine behavior */
     FName LastUsedKey;
 
+    /** Identifier for the next new layer, never reused */
+    UPROPERTY()
+    int32 NextLayerID;
+
+    /** Identifier for the next new spline point, never reused */
+    UPROPERTY()
+    int32 NextPointID;
+
+    /**
+    * Point identifier of each spline point as of the last rebuild, kept in sync by NotifySplinePointInserted and
+    * NotifySplinePointRemoved. Emptied once it no longer matches the spline
+    */
+    UPROPERTY()
+    TArray<int32> SplinePointIDs;
+
+    /** Identifier of each preset layer on this Flex Spline, so its random values survive reloads and preset edits */
+    UPROPERTY()
+    TMap<FName, int32> PresetLayerIDs;
+
+    /** Layout of all layers baked during cooking by layer identifier, editor saves never keep it */
+    UPROPERTY()
+    TMap<int32, FFlexBakedLayer> BakedLayers;
+
+    /**
+    * All layers in map order, gathered at the start of each rebuild. Points into the layer maps, so only valid
+    * until they change, e.g. by editing Mesh Layers without a rebuild. Use FindLayer across frames
+    */
+    TArray<FSplineMeshInitData*> Layers;
+
+    /** Spline evaluated at each spline point during the current rebuild */
+    TArray<FFlexSplineFrame> SplineFrames;
+
+    /** Arc length of the spline during the current rebuild, empty unless a layer places its meshes by distance */
+    FFlexArcLengthTable ArcLengthTable;
+
+    /** Per spline point hash of spline and point data from the last rebuild, used for dirty tracking */
+    TArray<uint32> PointHashCache;
+
+    /** Hash of global, mesh relevant settings from the last rebuild */
+    uint32 GlobalSettingsHash;
+
+    /** Was the layout baked into BakedLayers during cooking? */
+    UPROPERTY()
+    bool bHasBakedLayout;
+
+#if WITH_EDITOR
+    /** Bound while a cooked package with a baked layout is being saved */
+    FDelegateHandle PackageSavedHandle;
+#endif
+
+    /** Mesh updates waiting for time-sliced construction, in processing order */
+    TArray<FFlexPendingSegment> PendingSegmentOrder;
+
+    /** Index of the next entry of PendingSegmentOrder to process */
+    int32 NextPendingSegment;
+
+    /** Filled by each construction, see GetLastConstructionTimings */
+    FFlexConstructionTimings LastConstructionTimings;
+
+    /** Point and layer data memory in bytes, as last reported to the stats system */
+    SIZE_T ReportedPointDataMemory;
+    SIZE_T ReportedLayerDataMemory;
+
     /** Details customizer class needs access to all members */
     friend class FFlexSplineNodeBuilder;
+
+    /** Debug visualizer draws from the last rebuild's data */
+    friend class FFlexSplineDebugVisualizer;
+
+    /** Mesh baker deforms meshes exactly like UpdateSplineMesh does */
+    friend class FFlexSplineMeshBaker;
+
+    /** Benchmark sets up spline points, point data and layers directly */
+    friend class UFlexSplineBenchmarkCommandlet;
+
+    /** Automation test checks which point data survives spline edits */
+    friend class FFlexSplinePointDiffTest;
 };
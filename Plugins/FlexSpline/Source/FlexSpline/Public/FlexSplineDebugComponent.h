@@ -0,0 +1,26 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#pragma once
+
+#include "Components/ActorComponent.h"
+#include "FlexSplineDebugComponent.generated.h"
+
+/**
+* Editor-only companion of a Flex Spline. Holds no data itself, it only lets the editor find a
+* component visualizer that draws point numbers and up directions of the owning Flex Spline
+*/
+UCLASS(ClassGroup = FlexSpline)
+class FLEXSPLINE_API UFlexSplineDebugComponent : public UActorComponent
+{
+    GENERATED_BODY()
+
+public:
+
+    UFlexSplineDebugComponent();
+};
@@ -0,0 +1,41 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#pragma once
+
+#include "Engine/DataAsset.h"
+#include "FlexSplineActor.h"
+#include "FlexSplineLayerPreset.generated.h"
+
+/**
+* Mesh layers shared by any number of Flex Splines. Each Flex Spline instances the preset's layers without saving
+* them, an own layer of the same name overrides the preset's layer for that Flex Spline only
+*/
+UCLASS(BlueprintType)
+class FLEXSPLINE_API UFlexSplineLayerPreset : public UDataAsset
+{
+    GENERATED_BODY()
+
+public:
+
+    UFlexSplineLayerPreset();
+#if WITH_EDITOR
+    void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+
+public:
+
+    /** Layers built by every Flex Spline referencing this preset */
+    UPROPERTY(EditAnywhere, Category = "FlexSpline", meta = (DisplayName = "Mesh Layers", NoElementDuplicate))
+    TMap<FName, FSplineMeshInitData> Layers;
+
+    /** Blueprint for new "Mesh Layer" entries, of this preset and of Flex Splines referencing it */
+    UPROPERTY(EditAnywhere, Category = "FlexSpline", meta = (DisplayName = "Mesh Layer Template"))
+    FSplineMeshInitData LayerTemplate;
+};
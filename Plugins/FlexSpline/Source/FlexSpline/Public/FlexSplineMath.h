@@ -0,0 +1,474 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+
+/**
+* Placement math of Flex Spline layers, free of any engine types. Everything here works on plain structs and arrays,
+* so it can be compiled, profiled and verified by a native build outside of the editor. AFlexSplineActor converts its
+* engine types on the way in and out, FFlexMathVector and FFlexMathRotator share their layout with FVector and FRotator
+*/
+namespace FlexSplineMath
+{
+    struct FFlexMathVector
+    {
+        float X;
+        float Y;
+        float Z;
+    };
+
+    /** Euler angles in degrees, applied like FRotator: roll around X, then pitch around Y, then yaw around Z */
+    struct FFlexMathRotator
+    {
+        float Pitch;
+        float Yaw;
+        float Roll;
+    };
+
+    /** Inclusive range of spline point indices. Negative ends count from the last index */
+    struct FFlexMathRenderRange
+    {
+        int32_t Start;
+        int32_t End;
+        int32_t Step;
+    };
+
+    /** Random offset ranges of a layer, each random value is in [-Range, Range) */
+    struct FFlexMathRandomRanges
+    {
+        FFlexMathVector Location;
+        FFlexMathRotator Rotation;
+        FFlexMathVector Scale;
+
+        /** Use the X channel for all scale axes */
+        bool bUniformScale;
+    };
+
+    /** Random values of a single spline point or mesh */
+    struct FFlexMathRandomOffsets
+    {
+        FFlexMathVector Location;
+        FFlexMathRotator Rotation;
+        FFlexMathVector Scale;
+
+        /** Uniform random value in [0, 1), compared against the layer's spawn chance */
+        float SpawnRoll;
+    };
+
+    /** Independent random values drawn for each spline point. Append only, reordering changes all placements */
+    namespace ERandomChannel
+    {
+        enum Type : uint32_t
+        {
+              LocationX
+            , LocationY
+            , LocationZ
+            , RotationPitch
+            , RotationYaw
+            , RotationRoll
+            , ScaleX
+            , ScaleY
+            , ScaleZ
+            , SpawnChance
+            , SpacingJitter
+        };
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////
+    // VECTOR MATH
+    inline FFlexMathVector MakeVector(float X, float Y, float Z)
+    {
+        const FFlexMathVector result = { X, Y, Z };
+        return result;
+    }
+
+    inline FFlexMathVector Add(const FFlexMathVector& A, const FFlexMathVector& B)
+    {
+        return MakeVector(A.X + B.X, A.Y + B.Y, A.Z + B.Z);
+    }
+
+    inline FFlexMathVector Multiply(const FFlexMathVector& A, const FFlexMathVector& B)
+    {
+        return MakeVector(A.X * B.X, A.Y * B.Y, A.Z * B.Z);
+    }
+
+    inline FFlexMathRotator Add(const FFlexMathRotator& A, const FFlexMathRotator& B)
+    {
+        const FFlexMathRotator result = { A.Pitch + B.Pitch, A.Yaw + B.Yaw, A.Roll + B.Roll };
+        return result;
+    }
+
+    /** Sine and cosine of @param Value in radians, with the same minimax polynomials as FMath::SinCos */
+    inline void SinCos(float* OutSin, float* OutCos, float Value)
+    {
+        const float pi     = 3.1415926535897932f;
+        const float halfPi = 1.57079632679f;
+
+        // Map Value to [-pi, pi], then to [-pi/2, pi/2] with an unchanged sine
+        float quotient = (0.5f / pi) * Value;
+        quotient       = static_cast<float>(static_cast<int32_t>(Value >= 0.f ? quotient + 0.5f : quotient - 0.5f));
+        float y        = Value - (2.f * pi) * quotient;
+        float sign     = 1.f;
+        if (y > halfPi)
+        {
+            y    = pi - y;
+            sign = -1.f;
+        }
+        else if (y < -halfPi)
+        {
+            y    = -pi - y;
+            sign = -1.f;
+        }
+
+        const float y2 = y * y;
+        *OutSin = (((((-2.3889859e-08f * y2 + 2.7525562e-06f) * y2 - 0.00019840874f) * y2 + 0.0083333310f) * y2 - 0.16666667f) * y2 + 1.f) * y;
+        *OutCos = sign * ((((((-2.6051615e-07f * y2 + 2.4760495e-05f) * y2 - 0.0013888378f) * y2 + 0.041666638f) * y2 - 0.5f) * y2 + 1.f));
+    }
+
+    /** Rows of the rotation matrix of @param Rotator, laid out like FRotationMatrix */
+    struct FFlexMathBasis
+    {
+        FFlexMathVector X;
+        FFlexMathVector Y;
+        FFlexMathVector Z;
+    };
+
+    inline FFlexMathBasis MakeBasis(const FFlexMathRotator& Rotator)
+    {
+        const float degreesToRadians = 3.1415926535897932f / 180.f;
+        float sp, cp, sy, cy, sr, cr;
+        SinCos(&sp, &cp, Rotator.Pitch * degreesToRadians);
+        SinCos(&sy, &cy, Rotator.Yaw   * degreesToRadians);
+        SinCos(&sr, &cr, Rotator.Roll  * degreesToRadians);
+
+        FFlexMathBasis basis;
+        basis.X = MakeVector(cp * cy, cp * sy, sp);
+        basis.Y = MakeVector(sr * sp * cy - cr * sy, sr * sp * sy + cr * cy, -sr * cp);
+        basis.Z = MakeVector(-(cr * sp * cy + sr * sy), cy * sr - cr * sp * sy, cr * cp);
+        return basis;
+    }
+
+    inline FFlexMathVector RotateVector(const FFlexMathBasis& Basis, const FFlexMathVector& Vector)
+    {
+        return MakeVector(Vector.X * Basis.X.X + Vector.Y * Basis.Y.X + Vector.Z * Basis.Z.X,
+                          Vector.X * Basis.X.Y + Vector.Y * Basis.Y.Y + Vector.Z * Basis.Z.Y,
+                          Vector.X * Basis.X.Z + Vector.Y * Basis.Y.Z + Vector.Z * Basis.Z.Z);
+    }
+
+    inline FFlexMathVector RotateVector(const FFlexMathRotator& Rotator, const FFlexMathVector& Vector)
+    {
+        return RotateVector(MakeBasis(Rotator), Vector);
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////
+    // RANDOM VALUES
+    /** Finalizer of MurmurHash3, every input bit affects every output bit */
+    inline uint32_t MixRandomBits(uint32_t Value)
+    {
+        Value ^= Value >> 16;
+        Value *= 0x85ebca6b;
+        Value ^= Value >> 13;
+        Value *= 0xc2b2ae35;
+        Value ^= Value >> 16;
+        return Value;
+    }
+
+    inline uint32_t CombineRandomKey(uint32_t Key, uint32_t Value)
+    {
+        return MixRandomBits(Key ^ MixRandomBits(Value));
+    }
+
+    /** Stateless random value in [0, 1), identical for identical keys on every machine */
+    inline float RandomUnit(uint32_t PointKey, ERandomChannel::Type Channel)
+    {
+        // The upper 24 bits fit into a float's mantissa exactly
+        return (CombineRandomKey(PointKey, Channel) >> 8) * (1.f / 16777216.f);
+    }
+
+    /** Stateless random value in [-1, 1) */
+    inline float RandomSigned(uint32_t PointKey, ERandomChannel::Type Channel)
+    {
+        return RandomUnit(PointKey, Channel) * 2.f - 1.f;
+    }
+
+    /** Generate random values within @param Ranges for a single spline point or mesh, identified by @param Key */
+    inline void GenerateRandomOffset(const FFlexMathRandomRanges& Ranges, uint32_t Key, FFlexMathRandomOffsets& OutOffsets)
+    {
+        const float randomScaleX = RandomSigned(Key, ERandomChannel::ScaleX);
+        const float randomScaleY = Ranges.bUniformScale ? randomScaleX : RandomSigned(Key, ERandomChannel::ScaleY);
+        const float randomScaleZ = Ranges.bUniformScale ? randomScaleX : RandomSigned(Key, ERandomChannel::ScaleZ);
+
+        OutOffsets.Location       = Multiply(Ranges.Location, MakeVector(RandomSigned(Key, ERandomChannel::LocationX),
+                                                                         RandomSigned(Key, ERandomChannel::LocationY),
+                                                                         RandomSigned(Key, ERandomChannel::LocationZ)));
+        OutOffsets.Rotation.Pitch = Ranges.Rotation.Pitch * RandomSigned(Key, ERandomChannel::RotationPitch);
+        OutOffsets.Rotation.Yaw   = Ranges.Rotation.Yaw   * RandomSigned(Key, ERandomChannel::RotationYaw);
+        OutOffsets.Rotation.Roll  = Ranges.Rotation.Roll  * RandomSigned(Key, ERandomChannel::RotationRoll);
+        OutOffsets.Scale          = Multiply(Ranges.Scale, MakeVector(randomScaleX, randomScaleY, randomScaleZ));
+        OutOffsets.SpawnRoll      = RandomUnit(Key, ERandomChannel::SpawnChance);
+    }
+
+    /** Batch version of GenerateRandomOffset, the key of each point is combined from @param LayerSeed and its point identifier */
+    inline void GenerateRandomOffsets(const FFlexMathRandomRanges& Ranges, uint32_t LayerSeed, const int32_t* PointIDs,
+                                      int32_t Count, FFlexMathRandomOffsets* OutOffsets)
+    {
+        for (int32_t index = 0; index < Count; index++)
+        {
+            GenerateRandomOffset(Ranges, CombineRandomKey(LayerSeed, PointIDs[index]), OutOffsets[index]);
+        }
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////
+    // RENDER RULES
+    /** Does the accumulated spawn chance place a mesh at this index? Spreads meshes evenly instead of randomly */
+    inline bool CanRenderFromAccumulatedSpawnChance(float SpawnChance, int32_t CurrentIndex)
+    {
+        // Compare index-spawn-chance-ratio and see if it has changed from ratio of last index
+        const float clampedChance = SpawnChance < 0.00001f ? 0.00001f : (SpawnChance > 1.f ? 1.f : SpawnChance);
+        const float interval      = 1.f / clampedChance;
+        const int32_t currentRatio = static_cast<int32_t>(CurrentIndex / interval);
+        const int32_t lastRatio    = (CurrentIndex <= 0)
+                                   ? (SpawnChance > 0.f ? 1 : 0) // edge case first index
+                                   : (static_cast<int32_t>(((CurrentIndex - 1) / interval)));
+        return (currentRatio != lastRatio);
+    }
+
+    /** Render mode of a layer, see EFlexSplineRenderMode */
+    struct FFlexMathRenderMode
+    {
+        bool bHead;
+        bool bMiddle;
+        bool bTail;
+        bool bCustom;
+        bool bRanges;
+        bool bLoop;
+
+        /** Apply the accumulated spawn chance to all points */
+        bool bAccumulatedSpawnChance;
+        float SpawnChance;
+
+        const uint32_t* CustomIndices;
+        int32_t NumCustomIndices;
+
+        const FFlexMathRenderRange* Ranges;
+        int32_t NumRanges;
+    };
+
+    /**
+    * Set all points of @param OutMask rendered by @param Mode. Works on anything indexable that bools can be
+    * assigned to, e.g. a bool array or TBitArray. @param OutMask must hold @param NumPoints entries, all cleared
+    */
+    template <typename MaskType>
+    void CompileRenderMode(const FFlexMathRenderMode& Mode, int32_t NumPoints, MaskType& OutMask)
+    {
+        if (NumPoints <= 0)
+        {
+            return;
+        }
+
+        // When not looping, the final index should be one point earlier
+        const int32_t lastIndex  = Mode.bLoop ? (NumPoints - 1) : (NumPoints - 2);
+        const int32_t finalIndex = lastIndex > 0 ? lastIndex : 0;
+
+        if (Mode.bHead)
+        {
+            OutMask[0] = true;
+        }
+        if (Mode.bTail)
+        {
+            OutMask[finalIndex] = true;
+        }
+        if (Mode.bMiddle)
+        {
+            for (int32_t index = 1; index < finalIndex; index++)
+            {
+                OutMask[index] = true;
+            }
+        }
+        if (Mode.bCustom)
+        {
+            for (int32_t i = 0; i < Mode.NumCustomIndices; i++)
+            {
+                if (Mode.CustomIndices[i] < static_cast<uint32_t>(NumPoints))
+                {
+                    OutMask[Mode.CustomIndices[i]] = true;
+                }
+            }
+        }
+        if (Mode.bRanges)
+        {
+            for (int32_t i = 0; i < Mode.NumRanges; i++)
+            {
+                const FFlexMathRenderRange& range = Mode.Ranges[i];
+                const int32_t start   = range.Start > 0 ? range.Start : 0;
+                const int32_t rawEnd  = (range.End < 0) ? (NumPoints + range.End) : range.End;
+                const int32_t end     = rawEnd < (NumPoints - 1) ? rawEnd : (NumPoints - 1);
+                const int32_t step    = range.Step > 1 ? range.Step : 1;
+                for (int32_t index = start; index <= end; index += step)
+                {
+                    OutMask[index] = true;
+                }
+            }
+        }
+
+        // No loop, so cut out last mesh
+        if (!Mode.bLoop)
+        {
+            OutMask[NumPoints - 1] = false;
+        }
+
+        if (Mode.bAccumulatedSpawnChance)
+        {
+            for (int32_t index = 0; index < NumPoints; index++)
+            {
+                if (OutMask[index] && !CanRenderFromAccumulatedSpawnChance(Mode.SpawnChance, index))
+                {
+                    OutMask[index] = false;
+                }
+            }
+        }
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////
+    // PLACEMENT
+    /** Placement settings of a layer shared by all of its meshes */
+    struct FFlexMathPlacement
+    {
+        /** Location, rotation and up direction offsets are local to each spline point, see EFlexCoordinateSystem */
+        bool bLocationLocalToPoint;
+        bool bRotationLocalToPoint;
+        bool bUpDirectionLocalToPoint;
+
+        FFlexMathVector Location;
+        FFlexMathRotator Rotation;
+        FFlexMathVector Scale;
+        FFlexMathVector UpDirection;
+    };
+
+    /** Location of a static mesh, @param DirectionRotation is the coordinate system of the spline point */
+    inline FFlexMathVector ComputeLocation(const FFlexMathPlacement& Placement, const FFlexMathVector& FrameLocation,
+                                           const FFlexMathRotator& DirectionRotation, const FFlexMathVector& PointOffset,
+                                           const FFlexMathVector& RandomOffset)
+    {
+        // Rotation is linear, so all offsets share a single rotation into the spline point's coordinate system
+        const FFlexMathVector offset = Add(Add(Placement.Location, PointOffset), RandomOffset);
+        return Add(FrameLocation, Placement.bLocationLocalToPoint ? RotateVector(DirectionRotation, offset) : offset);
+    }
+
+    inline FFlexMathRotator ComputeRotation(const FFlexMathPlacement& Placement, const FFlexMathRotator& FrameRotation,
+                                            const FFlexMathRotator& PointRotation, const FFlexMathRotator& RandomRotation)
+    {
+        const FFlexMathRotator zeroRotator = { 0.f, 0.f, 0.f };
+        const FFlexMathRotator& splinePointRotation = Placement.bRotationLocalToPoint ? FrameRotation : zeroRotator;
+        return Add(Add(Add(Placement.Rotation, RandomRotation), PointRotation), splinePointRotation);
+    }
+
+    inline FFlexMathVector ComputeScale(const FFlexMathPlacement& Placement, const FFlexMathVector& FrameScale,
+                                        const FFlexMathVector& PointScale, const FFlexMathVector& RandomScale)
+    {
+        return Add(Add(Multiply(Placement.Scale, FrameScale), PointScale), RandomScale);
+    }
+
+    /** Up direction of a spline mesh, @param UpRotation is the up direction coordinate system of the spline point */
+    inline FFlexMathVector ComputeUpDirection(const FFlexMathPlacement& Placement, const FFlexMathRotator& UpRotation,
+                                              const FFlexMathVector& PointUpDirection)
+    {
+        const FFlexMathVector upDirection = Add(Placement.UpDirection, PointUpDirection);
+        return Placement.bUpDirectionLocalToPoint ? RotateVector(UpRotation, upDirection) : upDirection;
+    }
+
+    /** Start and end of a spline mesh between two spline points */
+    struct FFlexMathSegmentEnds
+    {
+        FFlexMathVector StartLocation;
+        FFlexMathVector EndLocation;
+
+        /** Relative location of the spline mesh component itself */
+        FFlexMathVector Location;
+    };
+
+    /** Coordinate system of a spline mesh layer's location offset, mirrors EFlexCoordinateSystem */
+    namespace ECoordinateSystem
+    {
+        enum Type : uint8_t
+        {
+              SplinePoint
+            , SplineSystem
+        };
+    }
+
+    /**
+    * Offset both ends of the spline mesh from spline point @param Start to @param End. Point local offsets move each
+    * end within its spline point's coordinate system, spline local offsets move the whole component instead
+    */
+    inline FFlexMathSegmentEnds ComputeSegmentEnds(ECoordinateSystem::Type CoordinateSystem, const FFlexMathVector& LayerLocation,
+                                                   const FFlexMathVector& StartLocation, const FFlexMathRotator& StartDirectionRotation,
+                                                   const FFlexMathVector& StartRandomOffset, const FFlexMathVector& EndLocation,
+                                                   const FFlexMathRotator& EndDirectionRotation, const FFlexMathVector& EndRandomOffset)
+    {
+        FFlexMathSegmentEnds ends;
+        ends.StartLocation = StartLocation;
+        ends.EndLocation   = EndLocation;
+        ends.Location      = MakeVector(0.f, 0.f, 0.f);
+
+        if (CoordinateSystem == ECoordinateSystem::SplinePoint)
+        {
+            ends.StartLocation = Add(ends.StartLocation, Add(RotateVector(StartDirectionRotation, LayerLocation), StartRandomOffset));
+            ends.EndLocation   = Add(ends.EndLocation,   Add(RotateVector(EndDirectionRotation,   LayerLocation), EndRandomOffset));
+        }
+        else if (CoordinateSystem == ECoordinateSystem::SplineSystem)
+        {
+            ends.Location = Add(LayerLocation, StartRandomOffset);
+        }
+
+        return ends;
+    }
+
+
+    //////////////////////////////////////////////////////////////////////////
+    // BATCHES
+    /** Locations of @param Count static meshes, all inputs are parallel arrays */
+    inline void ComputeLocations(const FFlexMathPlacement& Placement, const FFlexMathVector* FrameLocations,
+                                 const FFlexMathRotator* DirectionRotations, const FFlexMathVector* PointOffsets,
+                                 const FFlexMathVector* RandomOffsets, int32_t Count, FFlexMathVector* OutLocations)
+    {
+        for (int32_t index = 0; index < Count; index++)
+        {
+            OutLocations[index] = ComputeLocation(Placement, FrameLocations[index], DirectionRotations[index],
+                                                  PointOffsets[index], RandomOffsets[index]);
+        }
+    }
+
+    /** Rotations of @param Count static meshes, all inputs are parallel arrays */
+    inline void ComputeRotations(const FFlexMathPlacement& Placement, const FFlexMathRotator* FrameRotations,
+                                 const FFlexMathRotator* PointRotations, const FFlexMathRotator* RandomRotations,
+                                 int32_t Count, FFlexMathRotator* OutRotations)
+    {
+        for (int32_t index = 0; index < Count; index++)
+        {
+            OutRotations[index] = ComputeRotation(Placement, FrameRotations[index], PointRotations[index], RandomRotations[index]);
+        }
+    }
+
+    /** Scales of @param Count static meshes, all inputs are parallel arrays */
+    inline void ComputeScales(const FFlexMathPlacement& Placement, const FFlexMathVector* FrameScales,
+                              const FFlexMathVector* PointScales, const FFlexMathVector* RandomScales,
+                              int32_t Count, FFlexMathVector* OutScales)
+    {
+        for (int32_t index = 0; index < Count; index++)
+        {
+            OutScales[index] = ComputeScale(Placement, FrameScales[index], PointScales[index], RandomScales[index]);
+        }
+    }
+}
@@ -21,3 +21,6 @@ public:
 
 
 DECLARE_LOG_CATEGORY_EXTERN(FlexLog, Log, All);
+
+/** Shown by "stat FlexSpline", shared by the runtime and editor modules */
+DECLARE_STATS_GROUP(TEXT("FlexSpline"), STATGROUP_FlexSpline, STATCAT_Advanced);
@@ -44,6 +44,9 @@ public class FlexSplineDetails : ModuleRules
             , "PropertyEditor"
             , "ComponentVisualizers"
             , "EditorStyle"
+            , "RawMesh"
+            , "AssetRegistry"
+            , "Json"
         });
 
 
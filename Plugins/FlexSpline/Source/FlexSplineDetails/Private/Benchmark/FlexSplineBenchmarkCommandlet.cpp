@@ -0,0 +1,378 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#include "FlexSplineDetailsPrivatePCH.h"
+#include "FlexSplineBenchmarkCommandlet.h"
+#include "Components/SplineComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/Engine.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/JsonWriter.h"
+#include "ObjectTools.h"
+
+//////////////////////////////////////////////////////////////////////////
+// STATIC HELPERS
+
+/** Distance between two neighbouring spline points */
+static const float BenchmarkPointSpacing = 150.f;
+
+/** Reported phase of FFlexConstructionTimings */
+struct FFlexBenchmarkPhase
+{
+    const TCHAR* Name;
+    double FFlexConstructionTimings::* Time;
+};
+
+/** Reported counter of FFlexConstructionTimings */
+struct FFlexBenchmarkCounter
+{
+    const TCHAR* Name;
+    int32 FFlexConstructionTimings::* Count;
+};
+
+static const FFlexBenchmarkPhase BenchmarkPhases[] =
+{
+      { TEXT("GatherLayers"),      &FFlexConstructionTimings::GatherLayers }
+    , { TEXT("SplineFrames"),      &FFlexConstructionTimings::SplineFrames }
+    , { TEXT("PointDiff"),         &FFlexConstructionTimings::PointDiff }
+    , { TEXT("DirtyTracking"),     &FFlexConstructionTimings::DirtyTracking }
+    , { TEXT("ResolveSegments"),   &FFlexConstructionTimings::ResolveSegments }
+    , { TEXT("PrepareComponents"), &FFlexConstructionTimings::PrepareComponents }
+    , { TEXT("UpdateComponents"),  &FFlexConstructionTimings::UpdateComponents }
+};
+
+static const FFlexBenchmarkCounter BenchmarkCounters[] =
+{
+      { TEXT("DirtySegments"),     &FFlexConstructionTimings::NumDirtySegments }
+    , { TEXT("UpdatedSegments"),   &FFlexConstructionTimings::NumUpdatedSegments }
+    , { TEXT("CreatedComponents"), &FFlexConstructionTimings::NumCreatedComponents }
+    , { TEXT("ReusedComponents"),  &FFlexConstructionTimings::NumReusedComponents }
+};
+
+/** Parse a comma separated list of counts following @param Key, e.g. "-Points=10,100", or return @param Defaults */
+static TArray<int32> ParseCounts(const FString& Params, const TCHAR* Key, const TArray<int32>& Defaults)
+{
+    FString countsString;
+    if (!FParse::Value(*Params, Key, countsString, false))
+    {
+        return Defaults;
+    }
+
+    TArray<FString> countStrings;
+    countsString.ParseIntoArray(countStrings, TEXT(","));
+
+    TArray<int32> counts;
+    for (const FString& countString : countStrings)
+    {
+        const int32 count = FCString::Atoi(*countString);
+        if (count > 0)
+        {
+            counts.Add(count);
+        }
+    }
+    return counts;
+}
+
+static double ToMilliseconds(double Seconds)
+{
+    return Seconds * 1000.0;
+}
+
+static double ToMegabytes(double Bytes)
+{
+    return Bytes / (1024.0 * 1024.0);
+}
+
+static void WriteSampleJson(TJsonWriter<>& Writer, const TCHAR* Name, const FFlexBenchmarkSample& Sample)
+{
+    Writer.WriteObjectStart(Name);
+    Writer.WriteValue(TEXT("WallMs"), ToMilliseconds(Sample.WallTime));
+    for (const FFlexBenchmarkPhase& phase : BenchmarkPhases)
+    {
+        Writer.WriteValue(FString(phase.Name) + TEXT("Ms"), ToMilliseconds(Sample.Timings.*phase.Time));
+    }
+    for (const FFlexBenchmarkCounter& counter : BenchmarkCounters)
+    {
+        Writer.WriteValue(counter.Name, Sample.Timings.*counter.Count);
+    }
+    Writer.WriteObjectEnd();
+}
+
+static FString MakeSampleCsvRow(const FString& Label, const FFlexBenchmarkResult& Result, const TCHAR* Run, const FFlexBenchmarkSample& Sample)
+{
+    FString row = FString::Printf(TEXT("%s,%d,%d,%s,%.4f"), *Label, Result.NumPoints, Result.NumLayers, Run, ToMilliseconds(Sample.WallTime));
+    for (const FFlexBenchmarkPhase& phase : BenchmarkPhases)
+    {
+        row += FString::Printf(TEXT(",%.4f"), ToMilliseconds(Sample.Timings.*phase.Time));
+    }
+    for (const FFlexBenchmarkCounter& counter : BenchmarkCounters)
+    {
+        row += FString::Printf(TEXT(",%d"), Sample.Timings.*counter.Count);
+    }
+    row += FString::Printf(TEXT(",%d,%.2f,%.2f\n"), Result.NumComponents, ToMegabytes(Result.MemoryDelta), ToMegabytes(Result.MaxRetainedMemoryDelta));
+    return row;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// COMMANDLET
+UFlexSplineBenchmarkCommandlet::UFlexSplineBenchmarkCommandlet()
+    : SplineMeshAsset(nullptr)
+    , StaticMeshAsset(nullptr)
+{
+    IsClient     = false;
+    IsServer     = false;
+    IsEditor     = true;
+    LogToConsole = true;
+}
+
+int32 UFlexSplineBenchmarkCommandlet::Main(const FString& Params)
+{
+    const TArray<int32> pointCounts = ParseCounts(Params, TEXT("Points="), { 10, 100, 1000, 5000, 20000 });
+    const TArray<int32> layerCounts = ParseCounts(Params, TEXT("Layers="), { 1, 4, 16, 32 });
+    int32 numEdits                  = 5;
+    int32 maxSegments               = 0;
+    FString label                   = FDateTime::Now().ToString();
+    FString basePath;
+    FParse::Value(*Params, TEXT("Edits="), numEdits);
+    FParse::Value(*Params, TEXT("MaxSegments="), maxSegments);
+    FParse::Value(*Params, TEXT("Label="), label);
+    label = ObjectTools::SanitizeObjectName(label);
+    if (!FParse::Value(*Params, TEXT("Output="), basePath))
+    {
+        basePath = FPaths::GameSavedDir() / TEXT("FlexSplineBenchmark") / label;
+    }
+
+    SplineMeshAsset = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+    StaticMeshAsset = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cylinder.Cylinder"));
+    if (!SplineMeshAsset || !StaticMeshAsset)
+    {
+        UE_LOG(FlexDetailsLog, Error, TEXT("Flex Spline benchmark could not load the engine's basic shapes"));
+        return 1;
+    }
+
+    // Editor worlds never begin play and never time-slice construction, so every rebuild completes at once
+    UWorld* world               = UWorld::CreateWorld(EWorldType::Editor, false);
+    FWorldContext& worldContext = GEngine->CreateNewWorldContext(EWorldType::Editor);
+    worldContext.SetCurrentWorld(world);
+
+    TArray<FFlexBenchmarkResult> results;
+    for (const int32 numLayers : layerCounts)
+    {
+        for (const int32 numPoints : pointCounts)
+        {
+            // No cap unless given, so the default range is always measured in full
+            if (maxSegments > 0 && static_cast<int64>(numPoints) * numLayers > maxSegments)
+            {
+                UE_LOG(FlexDetailsLog, Display, TEXT("Skipping %d points x %d layers, exceeds -MaxSegments=%d"), numPoints, numLayers, maxSegments);
+                FFlexBenchmarkResult skipped;
+                skipped.NumPoints = numPoints;
+                skipped.NumLayers = numLayers;
+                skipped.bSkipped  = true;
+                results.Add(skipped);
+                continue;
+            }
+
+            results.Add(RunScenario(world, numPoints, numLayers, numEdits));
+            const FFlexBenchmarkResult& result = results.Last();
+            UE_LOG(FlexDetailsLog, Display, TEXT("%6d points x %2d layers: initial %9.2f ms, no-op %7.2f ms, point edit %7.2f ms, %7d components"),
+                   numPoints, numLayers,
+                   ToMilliseconds(result.InitialBuild.WallTime),
+                   ToMilliseconds(result.NoOpRebuild.WallTime),
+                   ToMilliseconds(result.PointEdit.WallTime),
+                   result.NumComponents);
+
+            // Start every scenario without garbage of the previous one
+            CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS);
+        }
+    }
+
+    GEngine->DestroyWorldContext(world);
+    world->DestroyWorld(false);
+
+    WriteResults(results, label, basePath);
+    return 0;
+}
+
+FFlexBenchmarkResult UFlexSplineBenchmarkCommandlet::RunScenario(UWorld* World, int32 NumPoints, int32 NumLayers, int32 NumEdits) const
+{
+    FFlexBenchmarkResult result;
+    result.NumPoints = NumPoints;
+    result.NumLayers = NumLayers;
+
+    // Memory is measured against the start of this scenario, earlier ones must not show up in its numbers
+    const int64 memoryBaseline = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical);
+    auto sampleRetainedMemory = [&]()
+    {
+        const int64 memoryDelta       = static_cast<int64>(FPlatformMemory::GetStats().UsedPhysical) - memoryBaseline;
+        result.MaxRetainedMemoryDelta = FMath::Max(result.MaxRetainedMemoryDelta, memoryDelta);
+        return memoryDelta;
+    };
+
+    AFlexSplineActor* flexSpline = World->SpawnActor<AFlexSplineActor>();
+    SetupFlexSpline(flexSpline, NumPoints, NumLayers);
+
+    const int64 memoryBefore = sampleRetainedMemory();
+    result.InitialBuild      = MeasureRebuild(flexSpline);
+    result.MemoryDelta       = sampleRetainedMemory() - memoryBefore;
+    result.NumComponents     = flexSpline->GetComponents().Num();
+    result.NoOpRebuild       = MeasureRebuild(flexSpline);
+    sampleRetainedMemory();
+
+    // Move the middle point up and back down again, each edit dirties the segments around it
+    USplineComponent* splineComponent = flexSpline->SplineComponent;
+    const int32 editIndex             = NumPoints / 2;
+    const FVector editLocation        = splineComponent->GetLocationAtSplinePoint(editIndex, ESplineCoordinateSpace::Local);
+    TArray<FFlexBenchmarkSample> editSamples;
+    for (int32 editCount = 0; editCount < NumEdits; editCount++)
+    {
+        const FVector offset = (editCount % 2 == 0) ? FVector(0.f, 0.f, 100.f) : FVector::ZeroVector;
+        splineComponent->SetLocationAtSplinePoint(editIndex, editLocation + offset, ESplineCoordinateSpace::Local, true);
+        editSamples.Add(MeasureRebuild(flexSpline));
+        sampleRetainedMemory();
+    }
+
+    if (editSamples.Num() > 0)
+    {
+        editSamples.Sort([](const FFlexBenchmarkSample& A, const FFlexBenchmarkSample& B)
+        {
+            return A.WallTime < B.WallTime;
+        });
+        result.PointEdit = editSamples[editSamples.Num() / 2];
+    }
+
+    flexSpline->Destroy();
+    return result;
+}
+
+void UFlexSplineBenchmarkCommandlet::SetupFlexSpline(AFlexSplineActor* FlexSpline, int32 NumPoints, int32 NumLayers) const
+{
+    // Meandering and slightly rising, so spline meshes bend and static meshes rotate
+    TArray<FVector> points;
+    points.Reserve(NumPoints);
+    for (int32 index = 0; index < NumPoints; index++)
+    {
+        points.Add(FVector(index * BenchmarkPointSpacing, FMath::Sin(index * 0.3f) * 200.f, FMath::Sin(index * 0.05f) * 50.f));
+    }
+    FlexSpline->SplineComponent->SetSplinePoints(points, ESplineCoordinateSpace::Local, true);
+
+    // Create point data before any layer exists, so synchronization can alternate per point
+    FlexSpline->Synchronize = EFlexGlobalConfigType::Custom;
+    FlexSpline->Loop        = EFlexGlobalConfigType::Custom;
+    FlexSpline->RandomSeed  = NumPoints ^ (NumLayers << 16);
+    FlexSpline->Rebuild();
+    FFlexPointDataChannels& pointData = FlexSpline->PointData;
+    for (int32 index = 0; index < pointData.Num(); index++)
+    {
+        pointData.SetSynchroniseWithPrevious(index, (index % 2 == 0));
+        pointData.SetEndRoll(index, (index % 5 == 0) ? 15.f : 0.f);
+    }
+
+    // Alternate mesh types, then vary instancing, looping and random offsets independently of them
+    for (int32 layerIndex = 0; layerIndex < NumLayers; layerIndex++)
+    {
+        FSplineMeshInitData& meshInitData = FlexSpline->MeshDataInitMap.Add(FName(*FString::Printf(TEXT("Layer %d"), layerIndex)));
+        meshInitData.Initialize();
+        meshInitData.GeneralInfo = 0;
+        SET_BIT(meshInitData.GeneralInfo, EFlexGeneralFlags::Active);
+
+        const bool bSplineMesh               = (layerIndex % 2 == 0);
+        meshInitData.MeshInfo.MeshType       = bSplineMesh ? EFlexSplineMeshType::SplineMesh : EFlexSplineMeshType::StaticMesh;
+        meshInitData.MeshInfo.Mesh           = bSplineMesh ? SplineMeshAsset : StaticMeshAsset;
+        meshInitData.MeshInfo.bUseInstancing = (layerIndex % 4 == 3);
+
+        if (layerIndex % 3 == 1)
+        {
+            SET_BIT(meshInitData.GeneralInfo, EFlexGeneralFlags::Loop);
+        }
+        if (layerIndex % 3 == 2)
+        {
+            meshInitData.LocationInfo.LocationRandomOffset  = FVector(0.f, 20.f, 5.f);
+            meshInitData.RotationInfo.RotationRandomOffset  = FRotator(0.f, 15.f, 0.f);
+            meshInitData.ScaleInfo.UniformScaleRandomOffset = 0.2f;
+            meshInitData.RenderInfo.SpawnChance             = 0.75f;
+            meshInitData.RenderInfo.bRandomizeSpawnChance   = true;
+        }
+    }
+}
+
+FFlexBenchmarkSample UFlexSplineBenchmarkCommandlet::MeasureRebuild(AFlexSplineActor* FlexSpline) const
+{
+    FFlexBenchmarkSample sample;
+    const double startTime = FPlatformTime::Seconds();
+    FlexSpline->Rebuild();
+    sample.WallTime        = FPlatformTime::Seconds() - startTime;
+    sample.Timings         = FlexSpline->GetLastConstructionTimings();
+    return sample;
+}
+
+void UFlexSplineBenchmarkCommandlet::WriteResults(const TArray<FFlexBenchmarkResult>& Results, const FString& Label, const FString& BasePath) const
+{
+    FString jsonString;
+    TSharedRef<TJsonWriter<>> jsonWriter = TJsonWriterFactory<>::Create(&jsonString);
+    jsonWriter->WriteObjectStart();
+    jsonWriter->WriteValue(TEXT("Label"), Label);
+    jsonWriter->WriteValue(TEXT("Platform"), FString(FPlatformProperties::IniPlatformName()));
+    jsonWriter->WriteValue(TEXT("NumCores"), FPlatformMisc::NumberOfCoresIncludingHyperthreads());
+    jsonWriter->WriteArrayStart(TEXT("Results"));
+    for (const FFlexBenchmarkResult& result : Results)
+    {
+        jsonWriter->WriteObjectStart();
+        jsonWriter->WriteValue(TEXT("Points"), result.NumPoints);
+        jsonWriter->WriteValue(TEXT("Layers"), result.NumLayers);
+        if (result.bSkipped)
+        {
+            jsonWriter->WriteValue(TEXT("Skipped"), true);
+            jsonWriter->WriteObjectEnd();
+            continue;
+        }
+        jsonWriter->WriteValue(TEXT("Components"), result.NumComponents);
+        jsonWriter->WriteValue(TEXT("MemoryDeltaMB"), ToMegabytes(result.MemoryDelta));
+        jsonWriter->WriteValue(TEXT("MaxRetainedMemoryDeltaMB"), ToMegabytes(result.MaxRetainedMemoryDelta));
+        WriteSampleJson(*jsonWriter, TEXT("InitialBuild"), result.InitialBuild);
+        WriteSampleJson(*jsonWriter, TEXT("NoOpRebuild"), result.NoOpRebuild);
+        WriteSampleJson(*jsonWriter, TEXT("PointEdit"), result.PointEdit);
+        jsonWriter->WriteObjectEnd();
+    }
+    jsonWriter->WriteArrayEnd();
+    jsonWriter->WriteObjectEnd();
+    jsonWriter->Close();
+
+    // One row per scenario and run, for spreadsheets and diffing across commits
+    FString csvString = TEXT("Label,Points,Layers,Run,WallMs");
+    for (const FFlexBenchmarkPhase& phase : BenchmarkPhases)
+    {
+        csvString += FString::Printf(TEXT(",%sMs"), phase.Name);
+    }
+    for (const FFlexBenchmarkCounter& counter : BenchmarkCounters)
+    {
+        csvString += FString::Printf(TEXT(",%s"), counter.Name);
+    }
+    csvString += TEXT(",Components,MemoryDeltaMB,MaxRetainedMemoryDeltaMB\n");
+    for (const FFlexBenchmarkResult& result : Results)
+    {
+        if (result.bSkipped)
+        {
+            continue;
+        }
+        csvString += MakeSampleCsvRow(Label, result, TEXT("InitialBuild"), result.InitialBuild);
+        csvString += MakeSampleCsvRow(Label, result, TEXT("NoOpRebuild"), result.NoOpRebuild);
+        csvString += MakeSampleCsvRow(Label, result, TEXT("PointEdit"), result.PointEdit);
+    }
+
+    const FString jsonPath = BasePath + TEXT(".json");
+    const FString csvPath  = BasePath + TEXT(".csv");
+    if (FFileHelper::SaveStringToFile(jsonString, *jsonPath) && FFileHelper::SaveStringToFile(csvString, *csvPath))
+    {
+        UE_LOG(FlexDetailsLog, Display, TEXT("Flex Spline benchmark results written to %s and %s"), *jsonPath, *csvPath);
+    }
+    else
+    {
+        UE_LOG(FlexDetailsLog, Error, TEXT("Flex Spline benchmark could not write results to %s"), *BasePath);
+    }
+}
@@ -0,0 +1,114 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "FlexSplineActor.h"
+#include "FlexSplineBenchmarkCommandlet.generated.h"
+
+/** Measurements of a single construction */
+struct FFlexBenchmarkSample
+{
+    /** Phase timings reported by the Flex Spline */
+    FFlexConstructionTimings Timings;
+
+    /** Wall time of the whole Rebuild call, in seconds */
+    double WallTime;
+
+    FFlexBenchmarkSample()
+        : WallTime(0.0)
+    {
+    }
+};
+
+/** All measurements of one combination of point and layer count */
+struct FFlexBenchmarkResult
+{
+    int32 NumPoints;
+    int32 NumLayers;
+
+    /** Was this combination skipped by -MaxSegments? If so, nothing else was measured */
+    bool bSkipped;
+
+    /** Construction of a freshly spawned Flex Spline, creating every component */
+    FFlexBenchmarkSample InitialBuild;
+
+    /** Rebuild without any changes */
+    FFlexBenchmarkSample NoOpRebuild;
+
+    /** Rebuild after moving a single spline point, median of all edits */
+    FFlexBenchmarkSample PointEdit;
+
+    /** Components owned by the Flex Spline after its initial construction */
+    int32 NumComponents;
+
+    /** Growth of used physical memory by the initial construction, in bytes */
+    int64 MemoryDelta;
+
+    /**
+    * Highest growth of used physical memory over the start of this scenario that is still held between rebuilds,
+    * in bytes. Sampled after setup and after each rebuild, so temporaries freed within a construction never show up.
+    * Not the peak of the process, which never decreases and would only repeat that of the largest scenario so far
+    */
+    int64 MaxRetainedMemoryDelta;
+
+    FFlexBenchmarkResult()
+        : NumPoints(0)
+        , NumLayers(0)
+        , bSkipped(false)
+        , NumComponents(0)
+        , MemoryDelta(0)
+        , MaxRetainedMemoryDelta(0)
+    {
+    }
+};
+
+/**
+* Measures how Flex Spline construction scales with point and layer counts. Runs headless, e.g.
+*
+*   UE4Editor-Cmd <Project> -run=FlexSplineBenchmark -nullrhi -Points=10,1000,20000 -Layers=1,8,32 -Edits=9 -Label=<Commit>
+*
+* Every scenario spawns a Flex Spline mixing spline and static mesh layers, instancing, looping, synchronization
+* and random offsets. Results are written as JSON and CSV to Saved/FlexSplineBenchmark/<Label>, or -Output=<Path>.
+* -MaxSegments=<Count> skips combinations of more points times layers, skipped ones are listed in the JSON
+*/
+UCLASS()
+class UFlexSplineBenchmarkCommandlet : public UCommandlet
+{
+    GENERATED_BODY()
+
+public:
+
+    UFlexSplineBenchmarkCommandlet();
+    int32 Main(const FString& Params) override;
+
+
+private:
+
+    /** Spawn a Flex Spline into @param World, then measure its initial construction, a no-op rebuild and single point edits */
+    FFlexBenchmarkResult RunScenario(UWorld* World, int32 NumPoints, int32 NumLayers, int32 NumEdits) const;
+
+    /** Create spline points, point data and layers of @param FlexSpline, without constructing any layer yet */
+    void SetupFlexSpline(AFlexSplineActor* FlexSpline, int32 NumPoints, int32 NumLayers) const;
+
+    /** Rebuild @param FlexSpline and measure it */
+    FFlexBenchmarkSample MeasureRebuild(AFlexSplineActor* FlexSpline) const;
+
+    /** Write @param Results to @param BasePath, as .json and .csv */
+    void WriteResults(const TArray<FFlexBenchmarkResult>& Results, const FString& Label, const FString& BasePath) const;
+
+
+private:
+
+    UPROPERTY(Transient)
+    UStaticMesh* SplineMeshAsset;
+
+    UPROPERTY(Transient)
+    UStaticMesh* StaticMeshAsset;
+};
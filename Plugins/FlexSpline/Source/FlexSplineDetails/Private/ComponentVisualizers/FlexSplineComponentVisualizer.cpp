@@ -0,0 +1,150 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+
+#include "FlexSplineDetailsPrivatePCH.h"
+#include "FlexSplineComponentVisualizer.h"
+#include "FlexSplineActor.h"
+#include "Components/SplineComponent.h"
+#include "ScopedTransaction.h"
+#include "Framework/Commands/InputBindingManager.h"
+#include "Framework/Commands/UICommandList.h"
+
+#define LOCTEXT_NAMESPACE "FlexSplineComponentVisualizer"
+
+//////////////////////////////////////////////////////////////////////////
+// STATIC HELPERS
+
+/** Returns the Flex Spline whose spline @param SplineComponent is, if any */
+static AFlexSplineActor* GetFlexSpline(USplineComponent* SplineComponent)
+{
+    AFlexSplineActor* flexSpline = SplineComponent ? Cast<AFlexSplineActor>(SplineComponent->GetOwner()) : nullptr;
+    return (flexSpline && flexSpline->GetSplineComponent() == SplineComponent) ? flexSpline : nullptr;
+}
+
+/** The engine registers its spline commands privately, so they are looked up by name */
+static TSharedPtr<FUICommandInfo> FindSplineCommand(const TCHAR* CommandName)
+{
+    return FInputBindingManager::Get().FindCommandInContext(TEXT("SplineComponentVisualizer"), CommandName);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// REGISTRATION
+void FFlexSplineComponentVisualizer::OnRegister()
+{
+    FSplineComponentVisualizer::OnRegister();
+
+    // Own bindings take precedence over the appended engine ones, all other commands stay untouched
+    const TSharedRef<FUICommandList> engineActions = SplineComponentVisualizerActions.ToSharedRef();
+    SplineComponentVisualizerActions               = MakeShareable(new FUICommandList);
+
+    const TSharedPtr<FUICommandInfo> deleteKey    = FindSplineCommand(TEXT("DeleteKey"));
+    const TSharedPtr<FUICommandInfo> duplicateKey = FindSplineCommand(TEXT("DuplicateKey"));
+    const TSharedPtr<FUICommandInfo> addKey       = FindSplineCommand(TEXT("AddKey"));
+    if (deleteKey.IsValid())
+    {
+        SplineComponentVisualizerActions->MapAction(deleteKey,
+            FExecuteAction::CreateSP(this, &FFlexSplineComponentVisualizer::OnDeleteFlexKey),
+            FCanExecuteAction::CreateSP(this, &FFlexSplineComponentVisualizer::CanDeleteKey));
+    }
+    if (duplicateKey.IsValid())
+    {
+        SplineComponentVisualizerActions->MapAction(duplicateKey,
+            FExecuteAction::CreateSP(this, &FFlexSplineComponentVisualizer::OnDuplicateFlexKey),
+            FCanExecuteAction::CreateSP(this, &FFlexSplineComponentVisualizer::IsKeySelectionValid));
+    }
+    if (addKey.IsValid())
+    {
+        SplineComponentVisualizerActions->MapAction(addKey,
+            FExecuteAction::CreateSP(this, &FFlexSplineComponentVisualizer::OnAddFlexKey),
+            FCanExecuteAction::CreateSP(this, &FFlexSplineComponentVisualizer::CanAddKey));
+    }
+    SplineComponentVisualizerActions->Append(engineActions);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// KEY EDITING
+void FFlexSplineComponentVisualizer::EditSelectedKeys(TFunctionRef<void()> Edit, const TArray<int32>& InsertOffsets, bool bRemove)
+{
+    USplineComponent* splineComponent = GetEditedSplineComponent();
+    AFlexSplineActor* flexSpline      = GetFlexSpline(splineComponent);
+    if (!flexSpline)
+    {
+        Edit();
+        return;
+    }
+
+    // Highest key first, so lower keys keep their index while reporting
+    TArray<int32> selectedKeys = SelectedKeys.Array();
+    selectedKeys.Sort(TGreater<int32>());
+
+    const int32 numPointsBefore = splineComponent->GetNumberOfSplinePoints();
+    Edit();
+    const int32 numPointsAfter  = splineComponent->GetNumberOfSplinePoints();
+
+    // The engine refused the edit, nothing to report. Any other surprise is left to location matching,
+    // since the identifiers no longer match the spline
+    const int32 expectedChange = selectedKeys.Num() * (bRemove ? -1 : InsertOffsets.Num());
+    if (numPointsAfter == numPointsBefore || numPointsAfter != numPointsBefore + expectedChange)
+    {
+        return;
+    }
+
+    for (const int32 selectedKey : selectedKeys)
+    {
+        if (bRemove)
+        {
+            flexSpline->NotifySplinePointRemoved(selectedKey);
+        }
+        for (const int32 insertOffset : InsertOffsets)
+        {
+            flexSpline->NotifySplinePointInserted(selectedKey + insertOffset);
+        }
+    }
+}
+
+// Each edit is wrapped in an outer transaction, so undo reverts the spline and the reported identifiers in one step
+void FFlexSplineComponentVisualizer::OnDeleteFlexKey()
+{
+    const FScopedTransaction transaction(LOCTEXT("DeleteKey", "Delete Spline Point"));
+    EditSelectedKeys([this]() { OnDeleteKey(); }, TArray<int32>(), true);
+}
+
+void FFlexSplineComponentVisualizer::OnDuplicateFlexKey()
+{
+    // Duplicates are inserted in front of their original
+    const FScopedTransaction transaction(LOCTEXT("DuplicateKey", "Duplicate Spline Point"));
+    EditSelectedKeys([this]() { OnDuplicateKey(); }, { 0 }, false);
+}
+
+void FFlexSplineComponentVisualizer::OnAddFlexKey()
+{
+    // New keys follow the last selected one, which is the only selected key by the time keys can be added
+    const FScopedTransaction transaction(LOCTEXT("AddKey", "Add Spline Point"));
+    EditSelectedKeys([this]() { OnAddKey(); }, { 1 }, false);
+}
+
+bool FFlexSplineComponentVisualizer::HandleInputDelta(FEditorViewportClient* ViewportClient, FViewport* Viewport, FVector& DeltaTranslate, FRotator& DeltaRotate, FVector& DeltaScale)
+{
+    if (!ViewportClient->IsAltPressed() || !bAllowDuplication)
+    {
+        return FSplineComponentVisualizer::HandleInputDelta(ViewportClient, Viewport, DeltaTranslate, DeltaRotate, DeltaScale);
+    }
+
+    // Alt-dragging duplicates the selected keys, already inside the viewport's drag transaction
+    bool bHandled = false;
+    EditSelectedKeys([&]()
+    {
+        bHandled = FSplineComponentVisualizer::HandleInputDelta(ViewportClient, Viewport, DeltaTranslate, DeltaRotate, DeltaScale);
+    }, { 0 }, false);
+    return bHandled;
+}
+
+#undef LOCTEXT_NAMESPACE
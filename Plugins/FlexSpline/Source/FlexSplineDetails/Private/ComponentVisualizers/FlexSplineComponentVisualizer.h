@@ -0,0 +1,34 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+
+#pragma once
+
+#include "SplineComponentVisualizer.h"
+
+/**
+ * Spline visualizer that reports keys it adds, duplicates or deletes to the owning Flex Spline,
+ * so point data keeps following its spline point. Behaves like the engine's visualizer for any other spline
+ */
+class FFlexSplineComponentVisualizer : public FSplineComponentVisualizer
+{
+public:
+
+    /** FComponentVisualizer interface */
+    void OnRegister() override;
+    bool HandleInputDelta(FEditorViewportClient* ViewportClient, FViewport* Viewport, FVector& DeltaTranslate, FRotator& DeltaRotate, FVector& DeltaScale) override;
+
+private:
+
+    /** Run the engine's key edit, then report the keys it inserted at @param InsertOffsets past or removed from each selected key */
+    void EditSelectedKeys(TFunctionRef<void()> Edit, const TArray<int32>& InsertOffsets, bool bRemove);
+
+    void OnDeleteFlexKey();
+    void OnDuplicateFlexKey();
+    void OnAddFlexKey();
+};
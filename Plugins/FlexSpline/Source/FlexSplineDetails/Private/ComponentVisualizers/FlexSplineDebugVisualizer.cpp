@@ -0,0 +1,123 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#include "FlexSplineDetailsPrivatePCH.h"
+#include "FlexSplineDebugVisualizer.h"
+#include "FlexSplineActor.h"
+#include "FlexSplineModule.h"
+#include "Components/SplineComponent.h"
+#include "SceneManagement.h"
+#include "CanvasItem.h"
+#include "CanvasTypes.h"
+#include "Engine/Engine.h"
+
+DECLARE_CYCLE_STAT(TEXT("Draw Up Directions"), STAT_FlexSplineDrawUpDirections, STATGROUP_FlexSpline);
+DECLARE_CYCLE_STAT(TEXT("Draw Point Numbers"), STAT_FlexSplineDrawPointNumbers, STATGROUP_FlexSpline);
+
+//////////////////////////////////////////////////////////////////////////
+// STATIC HELPERS
+static FColor GetColorForArrow(int32 MeshIndex)
+{
+    static const TArray<FColor> colors = {
+          FColor::Orange
+        , FColor::Green
+        , FColor::Blue
+        , FColor::Red
+        , FColor::Emerald
+        , FColor::Magenta
+        , FColor::Cyan
+        , FColor::Yellow
+        , FColor::Purple
+        , FColor::Turquoise
+        , FColor::Silver
+    };
+
+    MeshIndex = FMath::Clamp(MeshIndex, 0, colors.Num()-1);
+    return colors[MeshIndex];
+}
+
+/** Returns the Flex Spline owning the debug component, if any */
+static const AFlexSplineActor* GetFlexSpline(const UActorComponent* Component)
+{
+    return Component ? Cast<AFlexSplineActor>(Component->GetOwner()) : nullptr;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// VISUALIZATION
+void FFlexSplineDebugVisualizer::DrawVisualization(const UActorComponent* Component, const FSceneView* View, FPrimitiveDrawInterface* PDI)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineDrawUpDirections);
+    const AFlexSplineActor* flexSpline = GetFlexSpline(Component);
+    if (!flexSpline)
+    {
+        return;
+    }
+
+    const USplineComponent* splineComponent = flexSpline->SplineComponent;
+    const int32 numPoints                   = FMath::Min(splineComponent->GetNumberOfSplinePoints(), flexSpline->PointData.Num());
+    const FQuat splineRotation              = splineComponent->GetComponentQuat();
+    const FVector upVector                  = splineComponent->GetUpVector();
+    const float arrowLength                 = 80.f * flexSpline->UpDirectionArrowSize;
+
+    // Only visible spline meshes show their up direction, the last point has no segment of its own
+    for (int32 index = 0; index < numPoints - 1; index++)
+    {
+        const FVector arrowLocation = flexSpline->GetTextPosition(index) + upVector * flexSpline->UpDirectionArrowOffset;
+
+        int32 meshInitIndex = 0;
+        flexSpline->ForEachLayer([&](const FSplineMeshInitData& MeshInitData)
+        {
+            if (MeshInitData.UpVectorInfo.bShowUpDirection
+                && MeshInitData.MeshInfo.MeshType == EFlexSplineMeshType::SplineMesh
+                && MeshInitData.ResolvedSegments.IsValidIndex(index)
+                && MeshInitData.ResolvedSegments[index].bVisible)
+            {
+                const FVector arrowDirection = splineRotation.RotateVector(MeshInitData.ResolvedSegments[index].UpDirection);
+                const FMatrix arrowTransform = FRotationTranslationMatrix(arrowDirection.Rotation(), arrowLocation);
+                DrawDirectionalArrow(PDI, arrowTransform, GetColorForArrow(meshInitIndex), arrowLength, flexSpline->UpDirectionArrowSize, SDPG_Foreground);
+            }
+            meshInitIndex++;
+        });
+    }
+}
+
+void FFlexSplineDebugVisualizer::DrawVisualizationHUD(const UActorComponent* Component, const FViewport* Viewport, const FSceneView* View, FCanvas* Canvas)
+{
+    SCOPE_CYCLE_COUNTER(STAT_FlexSplineDrawPointNumbers);
+    const AFlexSplineActor* flexSpline = GetFlexSpline(Component);
+    if (!flexSpline || !flexSpline->bShowPointNumbers)
+    {
+        return;
+    }
+
+    const USplineComponent* splineComponent = flexSpline->SplineComponent;
+    const int32 numPoints                   = FMath::Min(splineComponent->GetNumberOfSplinePoints(), flexSpline->PointData.Num());
+    const UFont* font                       = GEngine->GetLargeFont();
+    const float fontHeight                  = FMath::Max(font->GetMaxCharHeight(), 1.f);
+
+    for (int32 index = 0; index < numPoints; index++)
+    {
+        // Project the text height as well, so numbers keep their world size like the former text renderers
+        const FVector textLocation = flexSpline->GetTextPosition(index);
+        FVector2D pixelLocation;
+        FVector2D pixelTop;
+        if (!View->WorldToPixel(textLocation, pixelLocation)
+            || !View->WorldToPixel(textLocation + View->GetViewUp() * flexSpline->PointNumberSize, pixelTop))
+        {
+            continue;
+        }
+
+        const float scale = FMath::Abs(pixelLocation.Y - pixelTop.Y) / fontHeight;
+        FCanvasTextItem textItem(pixelTop, FText::AsNumber(index), font, FLinearColor(flexSpline->TextRenderColor));
+        textItem.Scale    = FVector2D(scale, scale);
+        textItem.bCentreX = true;
+        textItem.EnableShadow(FLinearColor::Black);
+        Canvas->DrawItem(textItem);
+    }
+}
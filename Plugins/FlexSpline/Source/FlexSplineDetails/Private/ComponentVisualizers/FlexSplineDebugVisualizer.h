@@ -0,0 +1,24 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#pragma once
+
+#include "ComponentVisualizer.h"
+
+/**
+ * Draws point numbers and up direction arrows of the selected Flex Spline.
+ * Replaces text render and arrow components per spline point
+ */
+class FFlexSplineDebugVisualizer : public FComponentVisualizer
+{
+public:
+
+    /** FComponentVisualizer interface */
+    void DrawVisualization(const UActorComponent* Component, const FSceneView* View, FPrimitiveDrawInterface* PDI) override;
+    void DrawVisualizationHUD(const UActorComponent* Component, const FViewport* Viewport, const FSceneView* View, FCanvas* Canvas) override;
+};
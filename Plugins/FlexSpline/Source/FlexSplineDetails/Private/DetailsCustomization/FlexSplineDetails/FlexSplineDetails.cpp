@@ -28,12 +28,14 @@
 #include "SRotatorInputBox.h"
 #include "NumericUnitTypeInterface.inl"
 #include "SCheckBox.h"
+#include "SButton.h"
 #include "SBox.h"
 #include "STextBlock.h"
 #include "Components/SplineComponent.h"
 #include "UnrealEdGlobals.h"
 #include "SSCSEditor.h"
 #include "InputBoxes/FlexVectorInputBox.h"
+#include "MeshBaking/FlexSplineMeshBaker.h"
 
 
 class FFlexSplineNodeBuilder;
@@ -833,9 +835,9 @@ bool FFlexSplineNodeBuilder::IsSyncDisabled() const
         {
             for (int32 index : SelectedKeys)
             {
-                if (flex->PointDataArray.IsValidIndex(index))
+                if (flex->PointData.IsValidIndex(index))
                 {
-                    const bool bSyncWithPrev = flex->PointDataArray[index].bSynchroniseWithPrevious;
+                    const bool bSyncWithPrev = flex->PointData.GetSynchroniseWithPrevious(index);
                     if (bSyncWithPrev)
                     {
                         result = false;
@@ -1066,7 +1068,7 @@ void FFlexSplineNodeBuilder::OnSetStartRoll(float NewValue, EAxis::Type Axis, AF
 {
     for (int32 index : SelectedKeys)
     {
-        FlexSpline->PointDataArray[index].StartRoll = NewValue;
+        FlexSpline->PointData.SetStartRoll(index, NewValue);
     }
 }
 
@@ -1074,12 +1076,14 @@ void FFlexSplineNodeBuilder::OnSetStartScale(float NewValue, EAxis::Type Axis, A
 {
     for (int32 index : SelectedKeys)
     {
+        FVector2D scale = FlexSpline->PointData.GetStartScale(index);
         switch (Axis)
         {
-        case EAxis::X: FlexSpline->PointDataArray[index].StartScale.X = NewValue; break;
-        case EAxis::Y: FlexSpline->PointDataArray[index].StartScale.Y = NewValue; break;
+        case EAxis::X: scale.X = NewValue; break;
+        case EAxis::Y: scale.Y = NewValue; break;
         default: break;
         }
+        FlexSpline->PointData.SetStartScale(index, scale);
     }
 }
 
@@ -1087,12 +1091,14 @@ void FFlexSplineNodeBuilder::OnSetStartOffset(float NewValue, EAxis::Type Axis,
 {
     for (int32 index : SelectedKeys)
     {
+        FVector2D offset = FlexSpline->PointData.GetStartOffset(index);
         switch (Axis)
         {
-        case EAxis::X: FlexSpline->PointDataArray[index].StartOffset.X = NewValue; break;
-        case EAxis::Y: FlexSpline->PointDataArray[index].StartOffset.Y = NewValue; break;
+        case EAxis::X: offset.X = NewValue; break;
+        case EAxis::Y: offset.Y = NewValue; break;
         default: break;
         }
+        FlexSpline->PointData.SetStartOffset(index, offset);
     }
 }
 
@@ -1100,7 +1106,7 @@ void FFlexSplineNodeBuilder::OnSetEndRoll(float NewValue, EAxis::Type Axis, AFle
 {
     for (int32 index : SelectedKeys)
     {
-        FlexSpline->PointDataArray[index].EndRoll = NewValue;
+        FlexSpline->PointData.SetEndRoll(index, NewValue);
     }
 }
 
@@ -1108,12 +1114,14 @@ void FFlexSplineNodeBuilder::OnSetEndScale(float NewValue, EAxis::Type Axis, AFl
 {
     for (int32 index : SelectedKeys)
     {
+        FVector2D scale = FlexSpline->PointData.GetEndScale(index);
         switch (Axis)
         {
-        case EAxis::X: FlexSpline->PointDataArray[index].EndScale.X = NewValue; break;
-        case EAxis::Y: FlexSpline->PointDataArray[index].EndScale.Y = NewValue; break;
+        case EAxis::X: scale.X = NewValue; break;
+        case EAxis::Y: scale.Y = NewValue; break;
         default: break;
         }
+        FlexSpline->PointData.SetEndScale(index, scale);
     }
 }
 
@@ -1121,12 +1129,14 @@ void FFlexSplineNodeBuilder::OnSetEndOffset(float NewValue, EAxis::Type Axis, AF
 {
     for (int32 index : SelectedKeys)
     {
+        FVector2D offset = FlexSpline->PointData.GetEndOffset(index);
         switch (Axis)
         {
-        case EAxis::X: FlexSpline->PointDataArray[index].EndOffset.X = NewValue; break;
-        case EAxis::Y: FlexSpline->PointDataArray[index].EndOffset.Y = NewValue; break;
+        case EAxis::X: offset.X = NewValue; break;
+        case EAxis::Y: offset.Y = NewValue; break;
         default: break;
         }
+        FlexSpline->PointData.SetEndOffset(index, offset);
     }
 }
 
@@ -1134,13 +1144,15 @@ void FFlexSplineNodeBuilder::OnSetUpDirection(float NewValue, EAxis::Type Axis,
 {
     for (int32 index : SelectedKeys)
     {
+        FVector upDirection = FlexSpline->PointData.GetUpDirection(index);
         switch (Axis)
         {
-        case EAxis::X: FlexSpline->PointDataArray[index].CustomPointUpDirection.X = NewValue; break;
-        case EAxis::Y: FlexSpline->PointDataArray[index].CustomPointUpDirection.Y = NewValue; break;
-        case EAxis::Z: FlexSpline->PointDataArray[index].CustomPointUpDirection.Z = NewValue; break;
+        case EAxis::X: upDirection.X = NewValue; break;
+        case EAxis::Y: upDirection.Y = NewValue; break;
+        case EAxis::Z: upDirection.Z = NewValue; break;
         default: break;
         }
+        FlexSpline->PointData.SetUpDirection(index, upDirection);
     }
 }
 
@@ -1155,7 +1167,7 @@ void FFlexSplineNodeBuilder::OnCheckedChangedSynchroniseWithPrevious(ECheckBoxSt
         for (int32 index : SelectedKeys)
         {
             bool newValue = (NewState == ECheckBoxState::Checked);
-            flexSplineActor->PointDataArray[index].bSynchroniseWithPrevious = newValue;
+            flexSplineActor->PointData.SetSynchroniseWithPrevious(index, newValue);
         }
 
         NotifyPostChange(flexSplineActor);
@@ -1167,13 +1179,15 @@ void FFlexSplineNodeBuilder::OnSetSMLocationOffset(float NewValue, EAxis::Type A
 {
     for (int32 index : SelectedKeys)
     {
+        FVector offset = FlexSpline->PointData.GetSMLocationOffset(index);
         switch (Axis)
         {
-        case EAxis::X: FlexSpline->PointDataArray[index].SMLocationOffset.X = NewValue; break;
-        case EAxis::Y: FlexSpline->PointDataArray[index].SMLocationOffset.Y = NewValue; break;
-        case EAxis::Z: FlexSpline->PointDataArray[index].SMLocationOffset.Z = NewValue; break;
+        case EAxis::X: offset.X = NewValue; break;
+        case EAxis::Y: offset.Y = NewValue; break;
+        case EAxis::Z: offset.Z = NewValue; break;
         default: break;
         }
+        FlexSpline->PointData.SetSMLocationOffset(index, offset);
     }
 }
 
@@ -1181,13 +1195,15 @@ void FFlexSplineNodeBuilder::OnSetSMScale(float NewValue, EAxis::Type Axis, AFle
 {
     for (int32 index : SelectedKeys)
     {
+        FVector scale = FlexSpline->PointData.GetSMScale(index);
         switch (Axis)
         {
-        case EAxis::X: FlexSpline->PointDataArray[index].SMScale.X = NewValue; break;
-        case EAxis::Y: FlexSpline->PointDataArray[index].SMScale.Y = NewValue; break;
-        case EAxis::Z: FlexSpline->PointDataArray[index].SMScale.Z = NewValue; break;
+        case EAxis::X: scale.X = NewValue; break;
+        case EAxis::Y: scale.Y = NewValue; break;
+        case EAxis::Z: scale.Z = NewValue; break;
         default: break;
         }
+        FlexSpline->PointData.SetSMScale(index, scale);
     }
 }
 
@@ -1195,13 +1211,15 @@ void FFlexSplineNodeBuilder::OnSetSMRotation(float NewValue, EAxis::Type Axis, A
 {
     for (int32 index : SelectedKeys)
     {
+        FRotator rotation = FlexSpline->PointData.GetSMRotation(index);
         switch (Axis)
         {
-        case EAxis::X: FlexSpline->PointDataArray[index].SMRotation.Roll  = NewValue; break;
-        case EAxis::Y: FlexSpline->PointDataArray[index].SMRotation.Pitch = NewValue; break;
-        case EAxis::Z: FlexSpline->PointDataArray[index].SMRotation.Yaw   = NewValue; break;
+        case EAxis::X: rotation.Roll  = NewValue; break;
+        case EAxis::Y: rotation.Pitch = NewValue; break;
+        case EAxis::Z: rotation.Yaw   = NewValue; break;
         default: break;
         }
+        FlexSpline->PointData.SetSMRotation(index, rotation);
     }
 }
 
@@ -1228,9 +1246,9 @@ void FFlexSplineNodeBuilder::UpdateValues()
     {
         for (int32 index : SelectedKeys)
         {
-            if (flexSplineActor->PointDataArray.IsValidIndex(index))
+            if (flexSplineActor->PointData.IsValidIndex(index))
             {
-                const FSplinePointData& pointData = flexSplineActor->PointDataArray[index];
+                const FSplinePointData pointData = flexSplineActor->PointData.GetPoint(index);
 
                 StartRoll.Add(pointData.StartRoll);
                 StartScale.Add(pointData.StartScale);
@@ -1250,7 +1268,7 @@ void FFlexSplineNodeBuilder::UpdateValues()
 
 void FFlexSplineNodeBuilder::NotifyPreChange(AFlexSplineActor* FlexSplineActor)
 {
-    UProperty* startRollProperty = FindField<UProperty>(AFlexSplineActor::StaticClass(), "PointDataArray");
+    UProperty* startRollProperty = FindField<UProperty>(AFlexSplineActor::StaticClass(), "PointData");
     FlexSplineActor->PreEditChange(startRollProperty);
     if (NotifyHook)
     {
@@ -1260,7 +1278,7 @@ void FFlexSplineNodeBuilder::NotifyPreChange(AFlexSplineActor* FlexSplineActor)
 
 void FFlexSplineNodeBuilder::NotifyPostChange(AFlexSplineActor* FlexSplineActor)
 {
-    UProperty* startRollProperty = FindField<UProperty>(AFlexSplineActor::StaticClass(), "PointDataArray");
+    UProperty* startRollProperty = FindField<UProperty>(AFlexSplineActor::StaticClass(), "PointData");
     FPropertyChangedEvent PropertyChangedEvent(startRollProperty);
     if (NotifyHook)
     {
@@ -1286,6 +1304,37 @@ void FFlexSplineDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
     flexSplineNodeBuilder->DetailBuilder = &DetailBuilder;
     category.AddCustomBuilder(flexSplineNodeBuilder);
 
+    // Bake spline mesh layers of all selected Flex Splines into merged static meshes
+    TArray<TWeakObjectPtr<UObject>> customizedObjects;
+    DetailBuilder.GetObjectsBeingCustomized(customizedObjects);
+    IDetailCategoryBuilder& bakingCategory = DetailBuilder.EditCategory("FlexSplineBaking", LOCTEXT("FlexSplineBaking", "Flex Spline Baking"));
+    bakingCategory.AddCustomRow(LOCTEXT("BakeLayers", "Bake Layers"))
+        .NameContent()
+        .VAlign(VAlign_Center)
+        [
+            SNew(STextBlock)
+            .Text(LOCTEXT("BakeLayers", "Bake Layers"))
+            .Font(IDetailLayoutBuilder::GetDetailFont())
+        ]
+        .ValueContent()
+        [
+            SNew(SButton)
+            .Text(LOCTEXT("MergeIntoStaticMeshes", "Merge Into Static Meshes"))
+            .ToolTipText(LOCTEXT("MergeIntoStaticMeshesTip", "Deform and merge each spline mesh layer into static mesh assets next to the level, which then replace its spline meshes. Clears the undo history"))
+            .OnClicked_Lambda([customizedObjects]()
+            {
+                for (const TWeakObjectPtr<UObject>& object : customizedObjects)
+                {
+                    AFlexSplineActor* flexSpline = Cast<AFlexSplineActor>(object.Get());
+                    if (flexSpline)
+                    {
+                        FFlexSplineMeshBaker::BakeLayers(flexSpline);
+                    }
+                }
+                return FReply::Handled();
+            })
+        ];
+
     //You can get properties using the detail builder
     //MyProperty= DetailBuilder.GetProperty(GET_MEMBER_NAME_CHECKED(MyClass, MyClassPropertyName));
 }
@@ -8,7 +8,13 @@
 
 #include "FlexSplineDetailsPrivatePCH.h"
 #include "FlexSplineDetails/FlexSplineDetails.h"
+#include "ComponentVisualizers/FlexSplineDebugVisualizer.h"
+#include "ComponentVisualizers/FlexSplineComponentVisualizer.h"
+#include "FlexSplineDebugComponent.h"
+#include "Components/SplineComponent.h"
 #include "PropertyEditorModule.h"
+#include "UnrealEdGlobals.h"
+#include "Editor/UnrealEdEngine.h"
 
 #define LOCTEXT_NAMESPACE "FFlexSplineDetailsModule"
 
@@ -17,7 +23,23 @@ void FFlexSplineDetailsModule::StartupModule()
     // This code will execute after your module is loaded into memory; the exact timing is specified in the .uplugin file per-module
     FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
     PropertyModule.RegisterCustomClassLayout("FlexSplineActor", FOnGetDetailCustomizationInstance::CreateStatic(&FFlexSplineDetails::MakeInstance));
-    
+
+    // Point numbers and up directions are drawn by a visualizer instead of components per spline point
+    if (GUnrealEd)
+    {
+        TSharedPtr<FComponentVisualizer> debugVisualizer = MakeShareable(new FFlexSplineDebugVisualizer);
+        GUnrealEd->RegisterComponentVisualizer(UFlexSplineDebugComponent::StaticClass()->GetFName(), debugVisualizer);
+        debugVisualizer->OnRegister();
+
+        // Spline key edits report inserted and deleted points, so point data sticks to its point. Replaces the
+        // engine's spline visualizer, which has to be registered first
+        FModuleManager::Get().LoadModule(TEXT("ComponentVisualizers"));
+        const FName splineClassName                       = USplineComponent::StaticClass()->GetFName();
+        EngineSplineVisualizer                            = GUnrealEd->FindComponentVisualizer(splineClassName);
+        TSharedPtr<FComponentVisualizer> splineVisualizer = MakeShareable(new FFlexSplineComponentVisualizer);
+        GUnrealEd->RegisterComponentVisualizer(splineClassName, splineVisualizer);
+        splineVisualizer->OnRegister();
+    }
 }
 
 void FFlexSplineDetailsModule::ShutdownModule()
@@ -26,6 +48,19 @@ void FFlexSplineDetailsModule::ShutdownModule()
     // we call this function before unloading the module.
     FPropertyEditorModule& PropertyModule = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
     PropertyModule.UnregisterCustomClassLayout("FlexSplineActor");
+
+    if (GUnrealEd)
+    {
+        GUnrealEd->UnregisterComponentVisualizer(UFlexSplineDebugComponent::StaticClass()->GetFName());
+
+        const FName splineClassName = USplineComponent::StaticClass()->GetFName();
+        GUnrealEd->UnregisterComponentVisualizer(splineClassName);
+        if (EngineSplineVisualizer.IsValid())
+        {
+            GUnrealEd->RegisterComponentVisualizer(splineClassName, EngineSplineVisualizer);
+        }
+        EngineSplineVisualizer.Reset();
+    }
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,261 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#include "FlexSplineDetailsPrivatePCH.h"
+#include "FlexSplineMeshBaker.h"
+#include "FlexSplineActor.h"
+#include "Components/SplineMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "PhysicsEngine/BodySetup.h"
+#include "RawMesh.h"
+#include "AssetRegistryModule.h"
+#include "ObjectTools.h"
+#include "Editor.h"
+
+#define LOCTEXT_NAMESPACE "FlexSplineMeshBaker"
+
+//////////////////////////////////////////////////////////////////////////
+// STATIC HELPERS
+
+/** Deform @param Source along @param SplineMesh and append it to @param OutMesh, in the space of the spline mesh's parent */
+static void AppendDeformedMesh(const FRawMesh& Source, const USplineMeshComponent* SplineMesh, FRawMesh& OutMesh)
+{
+    const ESplineMeshAxis::Type forwardAxis = SplineMesh->ForwardAxis;
+    const FTransform componentTransform     = SplineMesh->GetRelativeTransform();
+    const int32 vertexOffset                = OutMesh.VertexPositions.Num();
+
+    // Each vertex is moved into the slice of the spline at its distance along the forward axis
+    TArray<FTransform> vertexTransforms;
+    vertexTransforms.Reserve(Source.VertexPositions.Num());
+    for (const FVector& vertex : Source.VertexPositions)
+    {
+        FVector position = vertex;
+        vertexTransforms.Add(SplineMesh->CalcSliceTransform(USplineMeshComponent::GetAxisValue(position, forwardAxis)) * componentTransform);
+        USplineMeshComponent::GetAxisValue(position, forwardAxis) = 0.f;
+        OutMesh.VertexPositions.Add(vertexTransforms.Last().TransformPosition(position));
+    }
+
+    // Tangent bases follow the slice of their vertex
+    for (int32 wedgeIndex = 0; wedgeIndex < Source.WedgeIndices.Num(); wedgeIndex++)
+    {
+        const int32 vertexIndex           = Source.WedgeIndices[wedgeIndex];
+        const FTransform& vertexTransform = vertexTransforms[vertexIndex];
+        OutMesh.WedgeIndices.Add(vertexIndex + vertexOffset);
+
+        if (Source.WedgeTangentX.IsValidIndex(wedgeIndex))
+        {
+            OutMesh.WedgeTangentX.Add(vertexTransform.TransformVectorNoScale(Source.WedgeTangentX[wedgeIndex]));
+        }
+        if (Source.WedgeTangentY.IsValidIndex(wedgeIndex))
+        {
+            OutMesh.WedgeTangentY.Add(vertexTransform.TransformVectorNoScale(Source.WedgeTangentY[wedgeIndex]));
+        }
+        if (Source.WedgeTangentZ.IsValidIndex(wedgeIndex))
+        {
+            OutMesh.WedgeTangentZ.Add(vertexTransform.TransformVectorNoScale(Source.WedgeTangentZ[wedgeIndex]));
+        }
+        if (Source.WedgeColors.IsValidIndex(wedgeIndex))
+        {
+            OutMesh.WedgeColors.Add(Source.WedgeColors[wedgeIndex]);
+        }
+        for (int32 uvIndex = 0; uvIndex < MAX_MESH_TEXTURE_COORDS; uvIndex++)
+        {
+            if (Source.WedgeTexCoords[uvIndex].IsValidIndex(wedgeIndex))
+            {
+                OutMesh.WedgeTexCoords[uvIndex].Add(Source.WedgeTexCoords[uvIndex][wedgeIndex]);
+            }
+        }
+    }
+
+    OutMesh.FaceMaterialIndices.Append(Source.FaceMaterialIndices);
+    OutMesh.FaceSmoothingMasks.Append(Source.FaceSmoothingMasks);
+}
+
+/** Create or overwrite the static mesh asset @param PackageName from @param RawMesh, using materials of @param SourceMesh */
+static UStaticMesh* CreateMergedMesh(const FString& PackageName, FRawMesh& RawMesh, const UStaticMesh* SourceMesh, UMaterialInterface* MaterialOverride)
+{
+    UPackage* package = CreatePackage(nullptr, *PackageName);
+    package->FullyLoad();
+
+    const FString assetName = FPackageName::GetLongPackageAssetName(PackageName);
+    UStaticMesh* staticMesh = FindObject<UStaticMesh>(package, *assetName);
+    const bool bIsNewAsset  = (staticMesh == nullptr);
+    if (bIsNewAsset)
+    {
+        staticMesh = NewObject<UStaticMesh>(package, FName(*assetName), RF_Public | RF_Standalone);
+    }
+    staticMesh->Modify();
+    staticMesh->SourceModels.Empty();
+
+    // Lightmap UVs are generated for the merged mesh, since UVs of the source mesh overlap for every segment
+    FStaticMeshSourceModel* sourceModel             = new(staticMesh->SourceModels) FStaticMeshSourceModel();
+    sourceModel->BuildSettings.bRecomputeNormals    = false;
+    sourceModel->BuildSettings.bRecomputeTangents   = false;
+    sourceModel->BuildSettings.bGenerateLightmapUVs = true;
+    sourceModel->BuildSettings.SrcLightmapIndex     = 0;
+    sourceModel->BuildSettings.DstLightmapIndex     = 1;
+    sourceModel->RawMeshBulkData->SaveRawMesh(RawMesh);
+
+    staticMesh->StaticMaterials         = SourceMesh->StaticMaterials;
+    staticMesh->LightMapCoordinateIndex = 1;
+    staticMesh->LightMapResolution      = SourceMesh->LightMapResolution;
+    if (MaterialOverride && staticMesh->StaticMaterials.Num() > 0)
+    {
+        staticMesh->StaticMaterials[0].MaterialInterface = MaterialOverride;
+    }
+
+    // A single collision body, built from the merged triangles
+    staticMesh->CreateBodySetup();
+    staticMesh->BodySetup->CollisionTraceFlag = CTF_UseComplexAsSimple;
+
+    staticMesh->Build(false);
+    staticMesh->PostEditChange();
+    package->MarkPackageDirty();
+    if (bIsNewAsset)
+    {
+        FAssetRegistryModule::AssetCreated(staticMesh);
+    }
+
+    return staticMesh;
+}
+
+/**
+* Let @param MeshInitData render @param MergedMeshes. Baked meshes of earlier bakes that are not among them belong to
+* chunks no longer populated, they are deleted instead of being left behind next to the level
+*/
+static void ReplaceMergedMeshes(FSplineMeshInitData& MeshInitData, const TArray<UStaticMesh*>& MergedMeshes, const FString& PackagePrefix)
+{
+    TArray<UObject*> staleMeshes;
+    for (UStaticMesh* mergedMesh : MeshInitData.MergeInfo.MergedMeshes)
+    {
+        // Only meshes baked for this Flex Spline, never assets assigned by hand
+        if (mergedMesh && !MergedMeshes.Contains(mergedMesh) && mergedMesh->GetOutermost()->GetName().StartsWith(PackagePrefix))
+        {
+            staleMeshes.AddUnique(mergedMesh);
+        }
+    }
+
+    MeshInitData.MergeInfo.MergedMeshes = MergedMeshes;
+    if (staleMeshes.Num() > 0)
+    {
+        ObjectTools::ForceDeleteObjects(staleMeshes, false);
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// BAKING
+int32 FFlexSplineMeshBaker::BakeLayers(AFlexSplineActor* FlexSpline)
+{
+    // Assets need a saved level to live next to
+    const FString levelPackageName = FlexSpline->GetOutermost()->GetName();
+    if (levelPackageName.StartsWith(TEXT("/Temp/")))
+    {
+        UE_LOG(FlexDetailsLog, Warning, TEXT("Save the level before baking %s"), *FlexSpline->GetName());
+        return 0;
+    }
+
+    // Creating, overwriting and deleting assets cannot be undone, so neither can baking
+    FlexSpline->Modify();
+
+    // Resolved segments must be up to date, including those of already merged layers
+    FlexSpline->RerunConstructionScripts();
+
+    const FString packagePrefix = FPaths::GetPath(levelPackageName) / FPackageName::GetShortName(levelPackageName)
+                                + TEXT("_FlexSpline/") + ObjectTools::SanitizeObjectName(FlexSpline->GetName());
+
+    // Preset layers are shared with other Flex Splines, they have to be overridden by an own layer to be baked
+    int32 numBakedLayers = 0;
+    for (auto& meshInitDataPair : FlexSpline->MeshDataInitMap)
+    {
+        numBakedLayers += BakeLayer(FlexSpline, meshInitDataPair.Value, packagePrefix) ? 1 : 0;
+    }
+
+    // Layers have changed settings now, so the next construction swaps their components for the merged meshes
+    FlexSpline->PostEditChange();
+
+    // Undoing an earlier edit would restore merged meshes that no longer exist or hold other geometry
+    GEditor->ResetTransaction(LOCTEXT("BakeLayers", "Bake Flex Spline Layers"));
+    return numBakedLayers;
+}
+
+bool FFlexSplineMeshBaker::BakeLayer(AFlexSplineActor* FlexSpline, FSplineMeshInitData& MeshInitData, const FString& PackagePrefix)
+{
+    UStaticMesh* sourceMesh = MeshInitData.MeshInfo.Mesh;
+    if (MeshInitData.MeshInfo.MeshType != EFlexSplineMeshType::SplineMesh
+        || !TEST_BIT(MeshInitData.GeneralInfo, EFlexGeneralFlags::Active)
+        || !sourceMesh
+        || sourceMesh->SourceModels.Num() == 0)
+    {
+        return false;
+    }
+
+    // Gather all segments the layer renders, grouped into chunks by their center
+    TMap<FIntVector, TArray<const FFlexResolvedSegment*>> chunks;
+    const float chunkSize = MeshInitData.MergeInfo.ChunkSize;
+    auto addSegment = [&](const FFlexResolvedSegment& Segment)
+    {
+        const FVector center = Segment.Location + 0.5f * (Segment.StartLocation + Segment.EndLocation);
+        const FIntVector key = (chunkSize > 0.f)
+                             ? FIntVector(FMath::FloorToInt(center.X / chunkSize), FMath::FloorToInt(center.Y / chunkSize), FMath::FloorToInt(center.Z / chunkSize))
+                             : FIntVector::ZeroValue;
+        chunks.FindOrAdd(key).Add(&Segment);
+    };
+
+    if (MeshInitData.IsAdaptive())
+    {
+        for (const FFlexResolvedSegment& segment : MeshInitData.AdaptiveSegments)
+        {
+            addSegment(segment);
+        }
+    }
+    else
+    {
+        for (TConstSetBitIterator<> visibleIt(MeshInitData.VisibilityMask); visibleIt; ++visibleIt)
+        {
+            addSegment(MeshInitData.ResolvedSegments[visibleIt.GetIndex()]);
+        }
+    }
+
+    if (chunks.Num() == 0)
+    {
+        ReplaceMergedMeshes(MeshInitData, TArray<UStaticMesh*>(), PackagePrefix);
+        return false;
+    }
+
+    FRawMesh sourceRawMesh;
+    sourceMesh->SourceModels[0].RawMeshBulkData->LoadRawMesh(sourceRawMesh);
+
+    // Deform with a transient spline mesh, set up by the same code as the Flex Spline's own components
+    USplineMeshComponent* splineMesh = NewObject<USplineMeshComponent>(GetTransientPackage());
+    splineMesh->SetStaticMesh(sourceMesh);
+
+    const FString layerPrefix = PackagePrefix + TEXT("_") + ObjectTools::SanitizeObjectName(MeshInitData.LayerName.ToString());
+    TArray<UStaticMesh*> mergedMeshes;
+    for (const auto& chunkPair : chunks)
+    {
+        FRawMesh mergedRawMesh;
+        for (const FFlexResolvedSegment* segment : chunkPair.Value)
+        {
+            FlexSpline->UpdateSplineMesh(MeshInitData, splineMesh, *segment);
+            AppendDeformedMesh(sourceRawMesh, splineMesh, mergedRawMesh);
+        }
+
+        const FIntVector& key     = chunkPair.Key;
+        const FString packageName = (chunkSize > 0.f)
+                                  ? FString::Printf(TEXT("%s_%d_%d_%d"), *layerPrefix, key.X, key.Y, key.Z)
+                                  : layerPrefix;
+        mergedMeshes.Add(CreateMergedMesh(packageName, mergedRawMesh, sourceMesh, MeshInitData.MeshInfo.MeshMaterial));
+    }
+
+    splineMesh->MarkPendingKill();
+    ReplaceMergedMeshes(MeshInitData, mergedMeshes, PackagePrefix);
+    return true;
+}
+
+#undef LOCTEXT_NAMESPACE
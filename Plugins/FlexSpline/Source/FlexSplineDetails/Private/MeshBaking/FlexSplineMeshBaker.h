@@ -0,0 +1,34 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+#pragma once
+
+class AFlexSplineActor;
+struct FSplineMeshInitData;
+
+/**
+ * Bakes spline mesh layers of a Flex Spline into merged static mesh assets. Every segment is deformed on the CPU
+ * exactly like its spline mesh component would deform it, then all segments (of a chunk) are merged into one mesh
+ */
+class FFlexSplineMeshBaker
+{
+public:
+
+    /**
+    * Bake all active spline mesh layers of @param FlexSpline and let them render the merged meshes instead.
+    * Assets are created next to the level, meshes of earlier bakes are overwritten or deleted. Cannot be undone,
+    * the undo history is cleared. Returns the number of baked layers
+    */
+    static int32 BakeLayers(AFlexSplineActor* FlexSpline);
+
+
+private:
+
+    /** Bake a single layer into one mesh per chunk, stored in its merge info. Returns false if there was nothing to bake */
+    static bool BakeLayer(AFlexSplineActor* FlexSpline, FSplineMeshInitData& MeshInitData, const FString& PackagePrefix);
+};
@@ -17,6 +17,11 @@ public:
     /** IModuleInterface implementation */
     virtual void StartupModule() override;
     virtual void ShutdownModule() override;
+
+private:
+
+    /** Spline visualizer registered before ours, restored on shutdown */
+    TSharedPtr<class FComponentVisualizer> EngineSplineVisualizer;
 };
 
 
@@ -0,0 +1,134 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+
+#include "FlexSplineMath.h"
+
+#include <chrono>
+#include <cstdio>
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+using namespace FlexSplineMath;
+
+/** Keeps results alive, so the compiler cannot drop the measured work */
+static volatile float Sink = 0.f;
+
+/** Time @param Function over @param Iterations runs and print the mean time per mesh */
+template <typename TFunction>
+static void Measure(const char* Name, int32_t NumMeshes, int32_t Iterations, TFunction Function)
+{
+    Function();
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for (int32_t iteration = 0; iteration < Iterations; iteration++)
+    {
+        Function();
+    }
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const double nanosecondsPerMesh = seconds * 1.e9 / (static_cast<double>(NumMeshes) * Iterations);
+    std::printf("%-24s %10.3f ms/batch %8.3f ns/mesh\n", Name, seconds * 1000.0 / Iterations, nanosecondsPerMesh);
+}
+
+int main(int argc, char** argv)
+{
+    const int32_t numMeshes  = argc > 1 ? std::atoi(argv[1]) : 100000;
+    const int32_t iterations = argc > 2 ? std::atoi(argv[2]) : 100;
+    if (numMeshes <= 0 || iterations <= 0)
+    {
+        std::printf("Usage: FlexSplineMathBenchmarks [NumMeshes] [Iterations]\n");
+        return 1;
+    }
+    std::printf("%d meshes, %d iterations\n", numMeshes, iterations);
+
+    // Inputs like those of a curved spline with random offsets
+    std::vector<FFlexMathVector> frameLocations(numMeshes), frameScales(numMeshes), pointOffsets(numMeshes), outVectors(numMeshes);
+    std::vector<FFlexMathRotator> frameRotations(numMeshes), outRotators(numMeshes);
+    std::vector<FFlexMathRandomOffsets> randomOffsets(numMeshes);
+    std::vector<int32_t> pointIDs(numMeshes);
+    std::vector<char> mask(numMeshes);
+
+    const FFlexMathRandomRanges ranges = { MakeVector(10.f, 10.f, 10.f), { 5.f, 180.f, 5.f }, MakeVector(0.2f, 0.2f, 0.2f), false };
+    for (int32_t index = 0; index < numMeshes; index++)
+    {
+        pointIDs[index]       = index;
+        frameLocations[index] = MakeVector(index * 100.f, (index % 17) * 10.f, 0.f);
+        frameScales[index]    = MakeVector(1.f, 1.f, 1.f);
+        pointOffsets[index]   = MakeVector(0.f, 0.f, (index % 3) * 5.f);
+        frameRotations[index].Pitch = (index % 7) * 3.f;
+        frameRotations[index].Yaw   = index * 0.5f;
+        frameRotations[index].Roll  = 0.f;
+    }
+    GenerateRandomOffsets(ranges, 1234u, pointIDs.data(), numMeshes, randomOffsets.data());
+
+    std::vector<FFlexMathVector> randomLocations(numMeshes), randomScales(numMeshes);
+    std::vector<FFlexMathRotator> randomRotations(numMeshes);
+    for (int32_t index = 0; index < numMeshes; index++)
+    {
+        randomLocations[index] = randomOffsets[index].Location;
+        randomRotations[index] = randomOffsets[index].Rotation;
+        randomScales[index]    = randomOffsets[index].Scale;
+    }
+
+    FFlexMathPlacement placement;
+    placement.bLocationLocalToPoint    = true;
+    placement.bRotationLocalToPoint    = true;
+    placement.bUpDirectionLocalToPoint = true;
+    placement.Location                 = MakeVector(0.f, 50.f, 0.f);
+    placement.Rotation                 = frameRotations[1];
+    placement.Scale                    = MakeVector(1.f, 1.f, 1.f);
+    placement.UpDirection              = MakeVector(0.f, 0.f, 1.f);
+
+    Measure("GenerateRandomOffsets", numMeshes, iterations, [&]()
+    {
+        GenerateRandomOffsets(ranges, 1234u, pointIDs.data(), numMeshes, randomOffsets.data());
+        Sink = randomOffsets[numMeshes - 1].SpawnRoll;
+    });
+
+    Measure("ComputeLocations local", numMeshes, iterations, [&]()
+    {
+        ComputeLocations(placement, frameLocations.data(), frameRotations.data(), pointOffsets.data(), randomLocations.data(), numMeshes, outVectors.data());
+        Sink = outVectors[numMeshes - 1].X;
+    });
+
+    placement.bLocationLocalToPoint = false;
+    Measure("ComputeLocations spline", numMeshes, iterations, [&]()
+    {
+        ComputeLocations(placement, frameLocations.data(), frameRotations.data(), pointOffsets.data(), randomLocations.data(), numMeshes, outVectors.data());
+        Sink = outVectors[numMeshes - 1].X;
+    });
+
+    Measure("ComputeRotations", numMeshes, iterations, [&]()
+    {
+        ComputeRotations(placement, frameRotations.data(), frameRotations.data(), randomRotations.data(), numMeshes, outRotators.data());
+        Sink = outRotators[numMeshes - 1].Yaw;
+    });
+
+    Measure("ComputeScales", numMeshes, iterations, [&]()
+    {
+        ComputeScales(placement, frameScales.data(), pointOffsets.data(), randomScales.data(), numMeshes, outVectors.data());
+        Sink = outVectors[numMeshes - 1].Z;
+    });
+
+    FFlexMathRenderMode mode = {};
+    mode.bHead                   = true;
+    mode.bMiddle                 = true;
+    mode.bTail                   = true;
+    mode.bAccumulatedSpawnChance = true;
+    mode.SpawnChance             = 0.3f;
+    Measure("CompileRenderMode", numMeshes, iterations, [&]()
+    {
+        std::fill(mask.begin(), mask.end(), 0);
+        CompileRenderMode(mode, numMeshes, mask);
+        Sink = mask[numMeshes / 2];
+    });
+
+    return 0;
+}
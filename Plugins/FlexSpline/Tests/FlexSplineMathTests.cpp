@@ -0,0 +1,364 @@
+/*****************************************************************************
+* Copyright (C) 2017 Oliver Hawk - All Rights Reserved
+*
+* @Author       Oliver Hawk
+* @EMail        *************************
+* @Package      Flex Spline
+******************************************************************************/
+
+
+#include "FlexSplineMath.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+using namespace FlexSplineMath;
+
+static int NumFailures = 0;
+
+#define TEST_TRUE(Expression) \
+    if (!(Expression)) { std::printf("%s:%d: %s failed\n", __FILE__, __LINE__, #Expression); NumFailures++; }
+
+#define TEST_EQUAL(Actual, Expected) \
+    if (!((Actual) == (Expected))) { std::printf("%s:%d: %s != %s\n", __FILE__, __LINE__, #Actual, #Expected); NumFailures++; }
+
+static const float Tolerance = 1.e-4f;
+
+static bool IsNear(float A, float B)
+{
+    return std::fabs(A - B) <= Tolerance * (std::fabs(B) > 1.f ? std::fabs(B) : 1.f);
+}
+
+static bool IsNear(const FFlexMathVector& A, float X, float Y, float Z)
+{
+    return IsNear(A.X, X) && IsNear(A.Y, Y) && IsNear(A.Z, Z);
+}
+
+static bool IsNear(const FFlexMathRotator& A, float Pitch, float Yaw, float Roll)
+{
+    return IsNear(A.Pitch, Pitch) && IsNear(A.Yaw, Yaw) && IsNear(A.Roll, Roll);
+}
+
+static FFlexMathRotator MakeRotator(float Pitch, float Yaw, float Roll)
+{
+    const FFlexMathRotator result = { Pitch, Yaw, Roll };
+    return result;
+}
+
+static FFlexMathPlacement MakePlacement(bool bLocalToPoint)
+{
+    FFlexMathPlacement placement;
+    placement.bLocationLocalToPoint    = bLocalToPoint;
+    placement.bRotationLocalToPoint    = bLocalToPoint;
+    placement.bUpDirectionLocalToPoint = bLocalToPoint;
+    placement.Location                 = MakeVector(1.f, 0.f, 0.f);
+    placement.Rotation                 = MakeRotator(10.f, 20.f, 30.f);
+    placement.Scale                    = MakeVector(2.f, 2.f, 2.f);
+    placement.UpDirection              = MakeVector(0.f, 0.f, 1.f);
+    return placement;
+}
+
+static FFlexMathRenderMode MakeRenderMode(bool bLoop)
+{
+    FFlexMathRenderMode mode;
+    std::memset(&mode, 0, sizeof(mode));
+    mode.bLoop = bLoop;
+    return mode;
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// RANDOM VALUES
+static void TestRandomValues()
+{
+    // MurmurHash3 finalizer reference values
+    TEST_EQUAL(MixRandomBits(0u), 0u);
+    TEST_EQUAL(MixRandomBits(1u), 0x514e28b7u);
+    TEST_EQUAL(MixRandomBits(42u), 0x087fcd5cu);
+    TEST_EQUAL(MixRandomBits(0xdeadbeefu), 0x0de5c6a9u);
+    TEST_EQUAL(CombineRandomKey(MixRandomBits(7u), 3u), 0xe85f9d9fu);
+
+    // Keys are order dependent, and identical keys give identical values
+    TEST_TRUE(CombineRandomKey(1u, 2u) != CombineRandomKey(2u, 1u));
+    TEST_EQUAL(CombineRandomKey(123u, 456u), CombineRandomKey(123u, 456u));
+    TEST_TRUE(IsNear(RandomUnit(12345u, ERandomChannel::SpawnChance), 0.856269121f));
+
+    const FFlexMathRandomRanges ranges = { MakeVector(10.f, 20.f, 30.f), MakeRotator(45.f, 90.f, 180.f), MakeVector(0.5f, 0.5f, 0.5f), true };
+    for (uint32_t key = 0; key < 1000; key++)
+    {
+        FFlexMathRandomOffsets first, second;
+        GenerateRandomOffset(ranges, key, first);
+        GenerateRandomOffset(ranges, key, second);
+        TEST_TRUE(std::memcmp(&first, &second, sizeof(first)) == 0);
+
+        TEST_TRUE(first.SpawnRoll >= 0.f && first.SpawnRoll < 1.f);
+        TEST_TRUE(std::fabs(first.Location.X) <= 10.f && std::fabs(first.Location.Z) <= 30.f);
+        TEST_TRUE(std::fabs(first.Rotation.Roll) <= 180.f);
+        TEST_TRUE(first.Scale.X == first.Scale.Y && first.Scale.X == first.Scale.Z);
+    }
+
+    // The batch combines each point identifier with the layer seed
+    const int32_t pointIDs[] = { 4, 8, 15 };
+    FFlexMathRandomOffsets batch[3], single;
+    GenerateRandomOffsets(ranges, 99u, pointIDs, 3, batch);
+    GenerateRandomOffset(ranges, CombineRandomKey(99u, 15u), single);
+    TEST_TRUE(std::memcmp(&batch[2], &single, sizeof(single)) == 0);
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// RENDER RULES
+static void TestAccumulatedSpawnChance()
+{
+    // Every second point, starting with the first
+    const bool expectedHalf[] = { true, false, true, false, true, false };
+    for (int32_t index = 0; index < 6; index++)
+    {
+        TEST_EQUAL(CanRenderFromAccumulatedSpawnChance(0.5f, index), expectedHalf[index]);
+    }
+
+    // Every third point
+    const bool expectedThird[] = { true, false, false, true, false, false, true };
+    for (int32_t index = 0; index < 7; index++)
+    {
+        TEST_EQUAL(CanRenderFromAccumulatedSpawnChance(1.f / 3.f, index), expectedThird[index]);
+    }
+
+    for (int32_t index = 0; index < 100; index++)
+    {
+        TEST_TRUE(CanRenderFromAccumulatedSpawnChance(1.f, index));
+        TEST_TRUE(CanRenderFromAccumulatedSpawnChance(2.f, index));
+        TEST_TRUE(!CanRenderFromAccumulatedSpawnChance(0.f, index));
+    }
+}
+
+static void TestCompileRenderMode()
+{
+    // First, last and middle without loop: the last spline point starts no segment
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(false);
+        bool mask[5] = {};
+        mode.bHead = true;
+        CompileRenderMode(mode, 5, mask);
+        const bool expected[] = { true, false, false, false, false };
+        TEST_TRUE(std::memcmp(mask, expected, sizeof(mask)) == 0);
+    }
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(false);
+        bool mask[5] = {};
+        mode.bTail = true;
+        CompileRenderMode(mode, 5, mask);
+        const bool expected[] = { false, false, false, true, false };
+        TEST_TRUE(std::memcmp(mask, expected, sizeof(mask)) == 0);
+    }
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(false);
+        bool mask[5] = {};
+        mode.bMiddle = true;
+        CompileRenderMode(mode, 5, mask);
+        const bool expected[] = { false, true, true, false, false };
+        TEST_TRUE(std::memcmp(mask, expected, sizeof(mask)) == 0);
+    }
+
+    // Looping, the last spline point connects back to the first
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(true);
+        bool mask[5] = {};
+        mode.bTail   = true;
+        mode.bMiddle = true;
+        CompileRenderMode(mode, 5, mask);
+        const bool expected[] = { false, true, true, true, true };
+        TEST_TRUE(std::memcmp(mask, expected, sizeof(mask)) == 0);
+    }
+
+    // Custom indices outside of the spline are ignored
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(true);
+        const uint32_t customIndices[] = { 1, 3, 17 };
+        bool mask[5] = {};
+        mode.bCustom          = true;
+        mode.CustomIndices    = customIndices;
+        mode.NumCustomIndices = 3;
+        CompileRenderMode(mode, 5, mask);
+        const bool expected[] = { false, true, false, true, false };
+        TEST_TRUE(std::memcmp(mask, expected, sizeof(mask)) == 0);
+    }
+
+    // Ranges with steps, negative ends count from the last index
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(true);
+        const FFlexMathRenderRange ranges[] = { { 1, -1, 2 }, { 0, 0, 1 } };
+        bool mask[6] = {};
+        mode.bRanges   = true;
+        mode.Ranges    = ranges;
+        mode.NumRanges = 2;
+        CompileRenderMode(mode, 6, mask);
+        const bool expected[] = { true, true, false, true, false, true };
+        TEST_TRUE(std::memcmp(mask, expected, sizeof(mask)) == 0);
+    }
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(false);
+        const FFlexMathRenderRange ranges[] = { { -3, 100, 1 } };
+        bool mask[6] = {};
+        mode.bRanges   = true;
+        mode.Ranges    = ranges;
+        mode.NumRanges = 1;
+        CompileRenderMode(mode, 6, mask);
+        const bool expected[] = { true, true, true, true, true, false };
+        TEST_TRUE(std::memcmp(mask, expected, sizeof(mask)) == 0);
+    }
+
+    // Accumulated spawn chance thins out the points that are set
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(true);
+        bool mask[6] = {};
+        mode.bHead                   = true;
+        mode.bMiddle                 = true;
+        mode.bTail                   = true;
+        mode.bAccumulatedSpawnChance = true;
+        mode.SpawnChance             = 0.5f;
+        CompileRenderMode(mode, 6, mask);
+        const bool expected[] = { true, false, true, false, true, false };
+        TEST_TRUE(std::memcmp(mask, expected, sizeof(mask)) == 0);
+    }
+
+    // Single point splines render at most their first point
+    {
+        FFlexMathRenderMode mode = MakeRenderMode(true);
+        bool mask[1] = {};
+        mode.bTail = true;
+        CompileRenderMode(mode, 1, mask);
+        TEST_TRUE(mask[0]);
+    }
+}
+
+
+//////////////////////////////////////////////////////////////////////////
+// PLACEMENT
+static void TestSinCos()
+{
+    for (float angle = -20.f; angle <= 20.f; angle += 0.01f)
+    {
+        float sine, cosine;
+        SinCos(&sine, &cosine, angle);
+        TEST_TRUE(std::fabs(sine - std::sin(angle)) < 1.e-5f);
+        TEST_TRUE(std::fabs(cosine - std::cos(angle)) < 1.e-5f);
+    }
+}
+
+static void TestComputeLocation()
+{
+    const FFlexMathVector frameLocation = MakeVector(10.f, 20.f, 30.f);
+    const FFlexMathVector pointOffset   = MakeVector(0.f, 2.f, 0.f);
+    const FFlexMathVector randomOffset  = MakeVector(0.f, 0.f, 3.f);
+
+    // Spline local offsets are summed
+    TEST_TRUE(IsNear(ComputeLocation(MakePlacement(false), frameLocation, MakeRotator(0.f, 90.f, 0.f), pointOffset, randomOffset), 11.f, 22.f, 33.f));
+
+    // Point local offsets turn with the spline point: yaw 90 maps X to Y and Y to -X
+    TEST_TRUE(IsNear(ComputeLocation(MakePlacement(true), frameLocation, MakeRotator(0.f, 90.f, 0.f), pointOffset, randomOffset), 8.f, 21.f, 33.f));
+
+    // Pitch 90 maps X to Z
+    TEST_TRUE(IsNear(ComputeLocation(MakePlacement(true), frameLocation, MakeRotator(90.f, 0.f, 0.f), MakeVector(0.f, 0.f, 0.f), MakeVector(0.f, 0.f, 0.f)), 10.f, 20.f, 31.f));
+}
+
+static void TestComputeRotation()
+{
+    const FFlexMathRotator frameRotation  = MakeRotator(1.f, 2.f, 3.f);
+    const FFlexMathRotator pointRotation  = MakeRotator(100.f, 0.f, 0.f);
+    const FFlexMathRotator randomRotation = MakeRotator(0.f, 0.f, -5.f);
+
+    TEST_TRUE(IsNear(ComputeRotation(MakePlacement(false), frameRotation, pointRotation, randomRotation), 110.f, 20.f, 25.f));
+    TEST_TRUE(IsNear(ComputeRotation(MakePlacement(true), frameRotation, pointRotation, randomRotation), 111.f, 22.f, 28.f));
+}
+
+static void TestComputeScale()
+{
+    TEST_TRUE(IsNear(ComputeScale(MakePlacement(false), MakeVector(1.f, 2.f, 3.f), MakeVector(0.5f, 0.f, 0.f), MakeVector(0.f, 0.f, -1.f)), 2.5f, 4.f, 5.f));
+}
+
+static void TestComputeUpDirection()
+{
+    // Spline local up directions are only offset by the spline point's up direction
+    TEST_TRUE(IsNear(ComputeUpDirection(MakePlacement(false), MakeRotator(90.f, 0.f, 0.f), MakeVector(0.f, 1.f, 0.f)), 0.f, 1.f, 1.f));
+
+    // Pitch 90 turns up into -X, roll 90 turns up into Y
+    TEST_TRUE(IsNear(ComputeUpDirection(MakePlacement(true), MakeRotator(90.f, 0.f, 0.f), MakeVector(0.f, 0.f, 0.f)), -1.f, 0.f, 0.f));
+    TEST_TRUE(IsNear(ComputeUpDirection(MakePlacement(true), MakeRotator(0.f, 0.f, 90.f), MakeVector(0.f, 0.f, 0.f)), 0.f, 1.f, 0.f));
+}
+
+static void TestComputeSegmentEnds()
+{
+    const FFlexMathVector layerLocation = MakeVector(0.f, 5.f, 0.f);
+    const FFlexMathVector start         = MakeVector(0.f, 0.f, 0.f);
+    const FFlexMathVector end           = MakeVector(100.f, 0.f, 0.f);
+    const FFlexMathVector startRandom   = MakeVector(0.f, 0.f, 1.f);
+    const FFlexMathVector endRandom     = MakeVector(0.f, 0.f, 2.f);
+
+    // Each end is offset within its own spline point's coordinate system
+    const FFlexMathSegmentEnds pointEnds = ComputeSegmentEnds(ECoordinateSystem::SplinePoint, layerLocation, start, MakeRotator(0.f, 0.f, 0.f),
+                                                              startRandom, end, MakeRotator(0.f, 90.f, 0.f), endRandom);
+    TEST_TRUE(IsNear(pointEnds.StartLocation, 0.f, 5.f, 1.f));
+    TEST_TRUE(IsNear(pointEnds.EndLocation, 95.f, 0.f, 2.f));
+    TEST_TRUE(IsNear(pointEnds.Location, 0.f, 0.f, 0.f));
+
+    // Spline local offsets move the whole component, using the start's random offset
+    const FFlexMathSegmentEnds splineEnds = ComputeSegmentEnds(ECoordinateSystem::SplineSystem, layerLocation, start, MakeRotator(0.f, 0.f, 0.f),
+                                                               startRandom, end, MakeRotator(0.f, 90.f, 0.f), endRandom);
+    TEST_TRUE(IsNear(splineEnds.StartLocation, 0.f, 0.f, 0.f));
+    TEST_TRUE(IsNear(splineEnds.EndLocation, 100.f, 0.f, 0.f));
+    TEST_TRUE(IsNear(splineEnds.Location, 0.f, 5.f, 1.f));
+}
+
+static void TestBatches()
+{
+    // Batches must match the single mesh functions exactly
+    const int32_t count = 7;
+    FFlexMathVector frameLocations[count], offsets[count], randoms[count], outLocations[count], outScales[count];
+    FFlexMathRotator directions[count], outRotations[count];
+    for (int32_t index = 0; index < count; index++)
+    {
+        frameLocations[index] = MakeVector(index * 100.f, 0.f, 0.f);
+        offsets[index]        = MakeVector(0.f, static_cast<float>(index), 0.f);
+        randoms[index]        = MakeVector(0.f, 0.f, -static_cast<float>(index));
+        directions[index]     = MakeRotator(index * 30.f, index * 45.f, index * 60.f);
+    }
+
+    const FFlexMathPlacement placement = MakePlacement(true);
+    ComputeLocations(placement, frameLocations, directions, offsets, randoms, count, outLocations);
+    ComputeRotations(placement, directions, directions, directions, count, outRotations);
+    ComputeScales(placement, offsets, offsets, randoms, count, outScales);
+    for (int32_t index = 0; index < count; index++)
+    {
+        const FFlexMathVector location = ComputeLocation(placement, frameLocations[index], directions[index], offsets[index], randoms[index]);
+        const FFlexMathRotator rotation = ComputeRotation(placement, directions[index], directions[index], directions[index]);
+        const FFlexMathVector scale    = ComputeScale(placement, offsets[index], offsets[index], randoms[index]);
+        TEST_TRUE(std::memcmp(&outLocations[index], &location, sizeof(location)) == 0);
+        TEST_TRUE(std::memcmp(&outRotations[index], &rotation, sizeof(rotation)) == 0);
+        TEST_TRUE(std::memcmp(&outScales[index], &scale, sizeof(scale)) == 0);
+    }
+}
+
+
+int main()
+{
+    TestRandomValues();
+    TestAccumulatedSpawnChance();
+    TestCompileRenderMode();
+    TestSinCos();
+    TestComputeLocation();
+    TestComputeRotation();
+    TestComputeScale();
+    TestComputeUpDirection();
+    TestComputeSegmentEnds();
+    TestBatches();
+
+    if (NumFailures > 0)
+    {
+        std::printf("%d checks failed\n", NumFailures);
+        return 1;
+    }
+    std::printf("All checks passed\n");
+    return 0;
+}